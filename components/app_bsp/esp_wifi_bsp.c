@@ -18,6 +18,8 @@ static const char *TAG = "WiFi";
 #define WIFI_CONNECTED_BIT BIT0
 #define WIFI_FAIL_BIT BIT1
 #define WIFI_MAX_RETRY 10
+// Wake for every 3rd beacon in modem sleep (~300 ms at the usual 100 TU)
+#define WIFI_LISTEN_INTERVAL 3
 
 static int s_retry_num = 0;
 
@@ -47,11 +49,13 @@ void espwifi_init(void) {
               .ssid = WIFI_SSID,
               .password = WIFI_PASSWORD,
               .threshold.authmode = WIFI_AUTH_WPA2_PSK,
+              .listen_interval = WIFI_LISTEN_INTERVAL,
           },
   };
   esp_wifi_set_mode(WIFI_MODE_STA);               // Set mode to STA
   esp_wifi_set_config(WIFI_IF_STA, &wifi_config); // Configure WiFi
   esp_wifi_start();                               // Start WiFi
+  esp_wifi_set_ps(WIFI_PS_MAX_MODEM); // Radio sleeps between beacons
 
   ESP_LOGI(TAG, "WiFi initialization complete, connecting to %s",
            wifi_config.sta.ssid);
@@ -87,6 +91,15 @@ static void event_handler(void *arg, esp_event_base_t event_base,
   }
 }
 
+// Radio off without tearing down the driver; the disconnect that follows
+// must not trigger the reconnect logic
+void espwifi_stop(void) {
+  s_retry_num = WIFI_MAX_RETRY;
+  esp_wifi_disconnect();
+  esp_wifi_stop();
+  user_esp_bsp.wifi_connected = false;
+}
+
 void espwifi_deinit(void) {
   esp_wifi_stop();
   esp_wifi_deinit();
@@ -18,6 +18,7 @@ extern "C" {
 #endif
 
 void espwifi_init(void);
+void espwifi_stop(void);
 void espwifi_deinit(void);
 int8_t espwifi_get_rssi(void);
 bool espwifi_is_connected(void);
@@ -4,17 +4,21 @@
 #include <esp_log.h>
 #include <esp_timer.h>
 #include "lvgl_bsp.h"
+#include "pm_bsp.h"
 
 static lv_disp_draw_buf_t disp_buf; 		// contains internal graphic buffer(s) called draw buffer(s)
 static lv_disp_drv_t disp_drv;      		// contains callback functions
 static SemaphoreHandle_t lvgl_mux = NULL;
+static TaskHandle_t lvgl_task = NULL;
 
 static const char *TAG = "LvglPort";
 
+#if !LV_TICK_CUSTOM
 static void Increase_lvgl_tick(void *arg)
 {
   	lv_tick_inc(LVGL_TICK_PERIOD_MS);
 }
+#endif
 
 bool Lvgl_lock(int timeout_ms)
 {
@@ -26,6 +30,12 @@ void Lvgl_unlock(void)
 {
   	assert(lvgl_mux && "bsp_display_start must be called first");
   	xSemaphoreGive(lvgl_mux);
+  	// Other tasks only take the lock to change widgets: let the port task
+  	// render now instead of when its next timer is due
+  	if (lvgl_task && xTaskGetCurrentTaskHandle() != lvgl_task)
+  	{
+  	  	xTaskNotifyGive(lvgl_task);
+  	}
 }
 
 static void Lvgl_port_task(void *arg)
@@ -35,18 +45,25 @@ static void Lvgl_port_task(void *arg)
   	{
   	  	if (Lvgl_lock(-1)) 
   	  	{
+  	  	  	// Rendering and the flush run at full clock, then back to DFS/sleep
+  	  	  	Pm_Acquire(PM_LOCK_RENDER);
   	  	  	task_delay_ms = lv_timer_handler();
+  	  	  	Pm_Release(PM_LOCK_RENDER);
   	  	  	//Release the mutex
   	  	  	Lvgl_unlock();
   	  	}
-  	  	if (task_delay_ms > LVGL_TASK_MAX_DELAY_MS)
-  	  	{
-  	  	  	task_delay_ms = LVGL_TASK_MAX_DELAY_MS;
-  	  	} else if (task_delay_ms < LVGL_TASK_MIN_DELAY_MS)
+  	  	// The refresh timer pauses itself once nothing is invalid, so with no
+  	  	// animation or timer pending this sleeps until Lvgl_unlock() wakes it
+  	  	TickType_t wait = portMAX_DELAY;
+  	  	if (task_delay_ms != LV_NO_TIMER_READY)
   	  	{
-  	  	  	task_delay_ms = LVGL_TASK_MIN_DELAY_MS;
+  	  	  	if (task_delay_ms < LVGL_TASK_MIN_DELAY_MS)
+  	  	  	{
+  	  	  	  	task_delay_ms = LVGL_TASK_MIN_DELAY_MS;
+  	  	  	}
+  	  	  	wait = pdMS_TO_TICKS(task_delay_ms);
   	  	}
-  	  	vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+  	  	ulTaskNotifyTake(pdTRUE, wait);
   	}
 }
 
@@ -66,10 +83,14 @@ void Lvgl_PortInit(int width, int height,DispFlushCb flush_cb) {
   	disp_drv.hor_res = width;
   	disp_drv.ver_res = height;
   	disp_drv.flush_cb = flush_cb;
-	disp_drv.full_refresh = 1;
+	// Redraw only invalidated areas; the flush sends them as panel windows
+	disp_drv.full_refresh = 0;
   	disp_drv.draw_buf = &disp_buf;
   	lv_disp_drv_register(&disp_drv);
 
+#if !LV_TICK_CUSTOM
+    // Without LV_TICK_CUSTOM (esp_timer_get_time) this wakes the CPU every
+    // LVGL_TICK_PERIOD_MS and keeps it out of light sleep
     ESP_LOGI(TAG, "Install LVGL tick timer");
   	esp_timer_create_args_t lvgl_tick_timer_args = {};
   	lvgl_tick_timer_args.callback = &Increase_lvgl_tick;
@@ -77,6 +98,7 @@ void Lvgl_PortInit(int width, int height,DispFlushCb flush_cb) {
     esp_timer_handle_t lvgl_tick_timer = NULL;
   	ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer));
   	ESP_ERROR_CHECK(esp_timer_start_periodic(lvgl_tick_timer,LVGL_TICK_PERIOD_MS * 1000));
+#endif
 
-    xTaskCreatePinnedToCore(Lvgl_port_task, "LVGL", 8 * 1024, NULL, 5, NULL, 0);
+    xTaskCreatePinnedToCore(Lvgl_port_task, "LVGL", 8 * 1024, NULL, 5, &lvgl_task, 0);
 }
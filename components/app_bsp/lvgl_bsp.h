@@ -3,8 +3,8 @@
 #include "lvgl.h"
 
 #define LVGL_TICK_PERIOD_MS    5
-#define LVGL_TASK_MAX_DELAY_MS 500
-#define LVGL_TASK_MIN_DELAY_MS 50
+#define LVGL_TASK_MAX_DELAY_MS 500 // Lock timeout for other tasks
+#define LVGL_TASK_MIN_DELAY_MS 50  // Frame pacing while timers are running
 
 typedef void (*DispFlushCb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 
@@ -11,18 +11,24 @@
 
 static const char *TAG = "SNTP";
 static bool time_synced = false;
+static sntp_sync_cb_t sync_cb = NULL;
 
 static void time_sync_notification_cb(struct timeval *tv) {
   ESP_LOGI(TAG, "Time synchronized with NTP server!");
   time_synced = true;
+  if (sync_cb) {
+    sync_cb();
+  }
 }
 
+void sntp_time_set_sync_cb(sntp_sync_cb_t cb) { sync_cb = cb; }
+
 void sntp_time_init(void) {
   ESP_LOGI(TAG, "Initializing SNTP client...");
 
   // Set timezone to CST (Central Standard Time = UTC-6)
   // CST6CDT means: 6 hours behind UTC, with daylight saving
-  setenv("TZ", "CST6CDT,M3.2.0,M11.1.0", 1);
+  setenv("TZ", SNTP_TIMEZONE, 1);
   tzset();
 
   // Configure SNTP
@@ -8,11 +8,21 @@
 extern "C" {
 #endif
 
+// POSIX TZ string for local time (Central, with daylight saving)
+#define SNTP_TIMEZONE "CST6CDT,M3.2.0,M11.1.0"
+
+typedef void (*sntp_sync_cb_t)(void);
+
 /**
  * @brief Initialize SNTP client and set timezone to CST (UTC-6)
  */
 void sntp_time_init(void);
 
+/**
+ * @brief Register a callback run (on the SNTP task) after every sync
+ */
+void sntp_time_set_sync_cb(sntp_sync_cb_t cb);
+
 /**
  * @brief Check if time has been synchronized with NTP server
  * @return true if synchronized, false otherwise
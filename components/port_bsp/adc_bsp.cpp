@@ -1,50 +1,242 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
 #include "adc_bsp.h"
 #include "esp_log.h"
 
+#define ADC_BATT_CHANNEL    ADC_CHANNEL_3
+#define ADC_DIVIDER         3.0f
+// read() only returns whole frames: several have to fill within a burst
+#define ADC_FRAME_BYTES     (64 * SOC_ADC_DIGI_RESULT_BYTES)
+#define ADC_POOL_BYTES      (4 * ADC_FRAME_BYTES)
+
+static const char *TAG = "Adc";
+
 static adc_cali_handle_t cali_handle;
-static adc_oneshot_unit_handle_t adc1_handle;
+static adc_continuous_handle_t adc_handle;
+static esp_timer_handle_t process_timer;
+static esp_timer_handle_t burst_timer;
+static uint8_t frame_buf[ADC_FRAME_BYTES];
+
+// LiPo open-circuit discharge curve, scaled so that 4.12 V (what this board's
+// charger tops out at) reads as full
+typedef struct {
+    float volts;
+    uint8_t percent;
+} soc_point_t;
+
+static const soc_point_t soc_curve[] = {
+    {4.12f, 100}, {4.06f, 95}, {4.01f, 90}, {3.97f, 85}, {3.93f, 80},
+    {3.90f, 75},  {3.87f, 70}, {3.84f, 65}, {3.81f, 60}, {3.79f, 55},
+    {3.77f, 50},  {3.76f, 45}, {3.75f, 40}, {3.74f, 35}, {3.73f, 30},
+    {3.71f, 25},  {3.69f, 20}, {3.66f, 15}, {3.62f, 10}, {3.55f, 5},
+    {3.30f, 0},
+};
+
+// Filter state, only touched by the timer callbacks
+static float median_win[ADC_MEDIAN_LEN];
+static int median_count = 0;
+static int median_pos = 0;
+static float ema_volts = 0;
+static float soc_history[ADC_RATE_WINDOW_MIN];
+static int soc_history_count = 0;
+static int soc_history_pos = 0;
+static int ticks_since_rate = 0;
+
+// Published results
+static portMUX_TYPE result_lock = portMUX_INITIALIZER_UNLOCKED;
+static float result_volts = 0;
+static uint8_t result_level = 0;
+static float result_rate = 0;
+static bool result_valid = false;
+
+static float Adc_VoltsToSoc(float volts) {
+    const int n = sizeof(soc_curve) / sizeof(soc_curve[0]);
+    if (volts >= soc_curve[0].volts) {
+        return 100.0f;
+    }
+    for (int i = 1; i < n; i++) {
+        if (volts >= soc_curve[i].volts) {
+            float span = soc_curve[i - 1].volts - soc_curve[i].volts;
+            float frac = (volts - soc_curve[i].volts) / span;
+            return soc_curve[i].percent + frac * (soc_curve[i - 1].percent - soc_curve[i].percent);
+        }
+    }
+    return 0.0f;
+}
+
+static float Adc_Median() {
+    float sorted[ADC_MEDIAN_LEN];
+    memcpy(sorted, median_win, median_count * sizeof(float));
+    for (int i = 1; i < median_count; i++) {
+        float v = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    return sorted[median_count / 2];
+}
+
+// Drain everything the DMA collected during the burst; returns the mean raw
+// reading, or -1 if nothing arrived
+static int Adc_DrainMean() {
+    uint32_t sum = 0;
+    uint32_t count = 0;
+    uint32_t len = 0;
+    while (adc_continuous_read(adc_handle, frame_buf, sizeof(frame_buf), &len, 0) == ESP_OK) {
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            adc_digi_output_data_t *p = (adc_digi_output_data_t *)&frame_buf[i];
+            if (p->type2.channel == ADC_BATT_CHANNEL) {
+                sum += p->type2.data;
+                count++;
+            }
+        }
+    }
+    return count ? (int)(sum / count) : -1;
+}
+
+static void Adc_Process(int raw) {
+    if (raw < 0) {
+        return;
+    }
+    int mv = 0;
+    if (adc_cali_raw_to_voltage(cali_handle, raw, &mv) != ESP_OK) {
+        return;
+    }
+    float volts = 0.001f * mv * ADC_DIVIDER;
+
+    median_win[median_pos] = volts;
+    median_pos = (median_pos + 1) % ADC_MEDIAN_LEN;
+    if (median_count < ADC_MEDIAN_LEN) {
+        median_count++;
+    }
+    float median = Adc_Median();
+    ema_volts = result_valid ? ema_volts + ADC_EMA_ALPHA * (median - ema_volts) : median;
+
+    float soc = Adc_VoltsToSoc(ema_volts);
+
+    // Discharge rate from the SoC a window ago, sampled once a minute
+    float rate = result_rate;
+    if (++ticks_since_rate >= 60000 / ADC_PROCESS_PERIOD_MS || soc_history_count == 0) {
+        ticks_since_rate = 0;
+        soc_history[soc_history_pos] = soc;
+        soc_history_pos = (soc_history_pos + 1) % ADC_RATE_WINDOW_MIN;
+        if (soc_history_count < ADC_RATE_WINDOW_MIN) {
+            soc_history_count++;
+        }
+        if (soc_history_count > 1) {
+            int oldest = (soc_history_pos - soc_history_count + ADC_RATE_WINDOW_MIN) % ADC_RATE_WINDOW_MIN;
+            float minutes = soc_history_count - 1;
+            rate = (soc_history[oldest] - soc) * 60.0f / minutes;
+        }
+    }
+
+    portENTER_CRITICAL(&result_lock);
+    // Hysteresis: the shown level only moves once the estimate has moved far
+    // enough, or when it reaches an end of the range
+    int level = (int)(soc + 0.5f);
+    if (!result_valid || abs(level - result_level) >= ADC_SOC_HYSTERESIS ||
+        level == 0 || level == 100) {
+        result_level = level;
+    }
+    result_volts = ema_volts;
+    result_rate = rate;
+    result_valid = true;
+    portEXIT_CRITICAL(&result_lock);
+}
+
+// Start of a reading; Adc_EndBurst collects it ADC_BURST_MS later
+static void Adc_BeginBurst(void *arg) {
+    if (adc_continuous_start(adc_handle) == ESP_OK) {
+        esp_timer_start_once(burst_timer, ADC_BURST_MS * 1000);
+    }
+}
 
+static void Adc_EndBurst(void *arg) {
+    int raw = Adc_DrainMean();
+    adc_continuous_stop(adc_handle);
+    Adc_Process(raw);
+}
 
 void Adc_PortInit() {
     adc_cali_curve_fitting_config_t cali_config = {};
     cali_config.unit_id = ADC_UNIT_1;
     cali_config.atten = ADC_ATTEN_DB_12;
     cali_config.bitwidth = ADC_BITWIDTH_12;
-  	ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, &cali_handle));
+    ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, &cali_handle));
+
+    adc_continuous_handle_cfg_t handle_config = {};
+    handle_config.max_store_buf_size = ADC_POOL_BYTES;
+    handle_config.conv_frame_size = ADC_FRAME_BYTES;
+    handle_config.flags.flush_pool = 1; // Keep the newest samples if we fall behind
+    ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_config, &adc_handle));
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_12;
+    pattern.channel = ADC_BATT_CHANNEL;
+    pattern.unit = ADC_UNIT_1;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_continuous_config_t config = {};
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = ADC_SAMPLE_FREQ_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    ESP_ERROR_CHECK(adc_continuous_config(adc_handle, &config));
+
+    // Prime the filters so the first reading is available right away
+    ESP_ERROR_CHECK(adc_continuous_start(adc_handle));
+    vTaskDelay(pdMS_TO_TICKS(ADC_BURST_MS) + 1);
+    Adc_EndBurst(NULL);
 
-    adc_oneshot_unit_init_cfg_t init_config1 = {};
-    init_config1.unit_id = ADC_UNIT_1;
-  	ESP_ERROR_CHECK(adc_oneshot_new_unit(&init_config1, &adc1_handle));
-  	adc_oneshot_chan_cfg_t config = {};
-    config.bitwidth = ADC_BITWIDTH_12;            
-    config.atten = ADC_ATTEN_DB_12;
-  	ESP_ERROR_CHECK(adc_oneshot_config_channel(adc1_handle, ADC_CHANNEL_3, &config));
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = Adc_EndBurst;
+    timer_args.name = "adc_burst";
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &burst_timer));
+    timer_args.callback = Adc_BeginBurst;
+    timer_args.name = "adc_process";
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &process_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(process_timer, ADC_PROCESS_PERIOD_MS * 1000));
+    ESP_LOGI(TAG, "Battery ADC: %d ms bursts at %d Hz every %d ms", ADC_BURST_MS,
+             ADC_SAMPLE_FREQ_HZ, ADC_PROCESS_PERIOD_MS);
 }
 
 float Adc_GetBatteryVoltage() {
-	int value;
-  	int tage = 0;
-    float vol = 0;
-  	esp_err_t err;
-  	err = adc_oneshot_read(adc1_handle,ADC_CHANNEL_3,&value);
-  	if(err == ESP_OK) {
-    	adc_cali_raw_to_voltage(cali_handle,value,&tage);
-    	vol = 0.001 * tage * 3;
-	}
-	return vol;
+    portENTER_CRITICAL(&result_lock);
+    float vol = result_volts;
+    portEXIT_CRITICAL(&result_lock);
+    return vol;
 }
 
 uint8_t Adc_GetBatteryLevel() {
-	float vol = Adc_GetBatteryVoltage();
-    if(vol < 3.0) {
-        return 0;
-    }
-    if(vol > 4.12) {
-        return 100;
+    portENTER_CRITICAL(&result_lock);
+    uint8_t level = result_level;
+    portEXIT_CRITICAL(&result_lock);
+    return level;
+}
+
+float Adc_GetDischargeRate() {
+    portENTER_CRITICAL(&result_lock);
+    float rate = result_rate;
+    portEXIT_CRITICAL(&result_lock);
+    return rate;
+}
+
+int Adc_GetMinutesRemaining() {
+    portENTER_CRITICAL(&result_lock);
+    float rate = result_rate;
+    uint8_t level = result_level;
+    portEXIT_CRITICAL(&result_lock);
+    // Below ~0.5 %/h the estimate is noise (or the battery is charging)
+    if (rate < 0.5f) {
+        return -1;
     }
-    float level = ((vol - 3.0) / 1.12) * 100;
-	//ESP_LOGW("Battery","Voltage: %.3f V, Level: %.1f %%",vol,level);
-    return (uint8_t)level;
+    return (int)(level / rate * 60.0f);
 }
@@ -1,7 +1,20 @@
 #pragma once
 
-#include <esp_adc/adc_oneshot.h>
+#include <esp_adc/adc_continuous.h>
+
+// Burst sampling: once per ADC_PROCESS_PERIOD_MS the DMA runs for
+// ADC_BURST_MS, then is stopped and the samples filtered. While running, the
+// driver holds an APB lock that keeps the chip out of light sleep.
+#define ADC_SAMPLE_FREQ_HZ       20000
+#define ADC_BURST_MS             10    // ~200 samples per reading
+#define ADC_PROCESS_PERIOD_MS    1000
+#define ADC_MEDIAN_LEN           5     // 1 s means; rejects WiFi TX sag
+#define ADC_EMA_ALPHA            0.2f
+#define ADC_SOC_HYSTERESIS       2     // % change needed before the level moves
+#define ADC_RATE_WINDOW_MIN      30    // Discharge rate averaging window
 
 void Adc_PortInit();
-float Adc_GetBatteryVoltage();
-uint8_t Adc_GetBatteryLevel();
\ No newline at end of file
+float Adc_GetBatteryVoltage();          // Filtered, volts
+uint8_t Adc_GetBatteryLevel();          // State of charge, %
+float Adc_GetDischargeRate();           // %/h; negative while charging
+int Adc_GetMinutesRemaining();          // -1 if unknown or charging
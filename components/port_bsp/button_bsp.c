@@ -2,6 +2,8 @@
 #include <driver/gpio.h>
 #include <esp_log.h>
 #include <esp_timer.h>
+#include <esp_sleep.h>
+#include <freertos/timers.h>
 #include "button_bsp.h"
 #include "multi_button.h"
 
@@ -18,6 +20,12 @@ static Button GP18Button;
 #define GP18_ID 2         
 #define GP18_Active 0       
 
+// The multi_button state machine is only ticked while a press sequence is in
+// progress. Idle buttons sit behind a low-level GPIO interrupt (also a light
+// sleep wake source) that restarts the ticks.
+static esp_timer_handle_t clock_tick_timer = NULL;
+static volatile bool ticks_running = false;
+
 /*******************Callback event declaration***************/
 static void on_boot_single_click(Button *btn_handle) {
     xEventGroupSetBits(BootButtonGroups, set_bit_button(0));
@@ -45,8 +53,47 @@ static void on_gp18_long_press_start(Button *btn_handle) {
 
 /*********************************************/
 
+static bool button_idle(Button *btn, int pin, int active_level) {
+    return btn->state == BTN_STATE_IDLE && gpio_get_level(pin) != active_level;
+}
+
 static void clock_task_callback(void *arg) {
     button_ticks();
+
+    if (button_idle(&BootButton, BOOT_KEY_PIN, BOOT_Active) &&
+        button_idle(&GP18Button, GP18_KEY_PIN, GP18_Active)) {
+        esp_timer_stop(clock_tick_timer);
+        ticks_running = false;
+        // Level triggered: a press that began after the check fires at once
+        gpio_intr_enable(BOOT_KEY_PIN);
+        gpio_intr_enable(GP18_KEY_PIN);
+    }
+}
+
+// Runs on the FreeRTOS timer task, deferred from the ISR
+static void start_ticks(void *arg, uint32_t unused) {
+    esp_timer_start_periodic(clock_tick_timer, TICKS_INTERVAL * 1000);
+}
+
+static void button_isr(void *arg) {
+    // Mask both pins until the state machine is idle again; otherwise the
+    // level interrupt would retrigger for as long as the button is held
+    gpio_intr_disable(BOOT_KEY_PIN);
+    gpio_intr_disable(GP18_KEY_PIN);
+
+    BaseType_t woken = pdFALSE;
+    if (!ticks_running) {
+        ticks_running = true;
+        if (xTimerPendFunctionCallFromISR(start_ticks, NULL, 0, &woken) != pdPASS) {
+            // Timer queue full: nothing would ever unmask the pins. Unmask
+            // them here; while the button is held the level interrupt fires
+            // again and retries once the timer task has drained the queue.
+            ticks_running = false;
+            gpio_intr_enable(BOOT_KEY_PIN);
+            gpio_intr_enable(GP18_KEY_PIN);
+        }
+    }
+    portYIELD_FROM_ISR(woken);
 }
 
 static uint8_t read_button_GPIO(uint8_t Button_ID) {
@@ -63,13 +110,18 @@ static uint8_t read_button_GPIO(uint8_t Button_ID) {
 
 static void gpio_init(void) {
     gpio_config_t gpio_conf = {};
-    gpio_conf.intr_type     = GPIO_INTR_DISABLE;
+    gpio_conf.intr_type     = GPIO_INTR_LOW_LEVEL;
     gpio_conf.mode          = GPIO_MODE_INPUT;
     gpio_conf.pin_bit_mask  = (0x1ULL << BOOT_KEY_PIN) | (0x1ULL << GP18_KEY_PIN);
     gpio_conf.pull_down_en  = GPIO_PULLDOWN_DISABLE;
     gpio_conf.pull_up_en    = GPIO_PULLUP_ENABLE;
 
     ESP_ERROR_CHECK_WITHOUT_ABORT(gpio_config(&gpio_conf));
+
+    // Either button wakes the chip from light sleep
+    gpio_wakeup_enable(BOOT_KEY_PIN, GPIO_INTR_LOW_LEVEL);
+    gpio_wakeup_enable(GP18_KEY_PIN, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
 }
 
 void Custom_ButtonInit(void) {
@@ -91,11 +143,14 @@ void Custom_ButtonInit(void) {
     clock_tick_timer_args.callback                = &clock_task_callback;
     clock_tick_timer_args.name                    = "clock_task";
     clock_tick_timer_args.arg                     = NULL;
-    esp_timer_handle_t clock_tick_timer           = NULL;
     ESP_ERROR_CHECK(esp_timer_create(&clock_tick_timer_args, &clock_tick_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(clock_tick_timer, 1000 * 5)); // 5ms
     button_start(&BootButton);
     button_start(&GP18Button);
+
+    // Ticks (5 ms) start on the first press
+    gpio_install_isr_service(0);
+    gpio_isr_handler_add(BOOT_KEY_PIN, button_isr, NULL);
+    gpio_isr_handler_add(GP18_KEY_PIN, button_isr, NULL);
 }
 
 uint8_t user_boot_get_repeat_count(void) {
@@ -54,15 +54,8 @@ i2cbus_(i2cbus)
     playback = get_playback_handle();
     record   = get_record_handle();
 
-    i2c_master_bus_handle_t I2cMasterBus = i2cbus_.Get_I2cBusHandle();
-    i2c_device_config_t dev_cfg = {};
-    dev_cfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
-    dev_cfg.device_address  = Es8311Address;
-    dev_cfg.scl_speed_hz    = 400000;
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(I2cMasterBus, &dev_cfg, &I2c_DevEs8311));
-
-    dev_cfg.device_address  = Es7210Address;
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(I2cMasterBus, &dev_cfg, &I2c_DevEs7210));
+    I2c_DevEs8311 = i2cbus_.i2c_add_device(Es8311Address, 400000);
+    I2c_DevEs7210 = i2cbus_.i2c_add_device(Es7210Address, 400000);
 }
 
 CodecPort::~CodecPort() {
@@ -3,6 +3,7 @@
 #include <freertos/FreeRTOS.h>
 #include <esp_log.h>
 #include "display_bsp.h"
+#include "splash_frame.h"
 
 DisplayPort::DisplayPort(int mosi, int scl, int dc, int cs, int rst, int width, int height, spi_host_device_t spihost) : 
 mosi_(mosi), 
@@ -49,6 +50,8 @@ height_(height)
     DisplayLen                = transfer >> 3; //(1byte 8ipex)
     DispBuffer                = (uint8_t *) heap_caps_malloc(DisplayLen, MALLOC_CAP_SPIRAM);
     assert(DispBuffer);
+    WindowBuffer              = (uint8_t *) heap_caps_malloc(DisplayLen, MALLOC_CAP_SPIRAM);
+    assert(WindowBuffer);
 
 #if (AlgorithmOptimization == 3)
 	PixelIndexLUT = (uint16_t (*)[300])heap_caps_malloc(transfer * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
@@ -66,7 +69,7 @@ height_(height)
 DisplayPort::~DisplayPort() {
 }
 
-void DisplayPort::RLCD_Init() {
+bool DisplayPort::RLCD_Init() {
     RLCD_Reset();
 
     RLCD_SendCommand(0xD6);  // NVM Load Control
@@ -180,7 +183,15 @@ void DisplayPort::RLCD_Init() {
 	RLCD_SendCommand(0x38);
 	RLCD_SendCommand(0x29);
 
+    // First frame straight from flash: the static dashboard chrome, already
+    // packed, in one transfer. LVGL draws the same pixels over it later.
+    if ((int)rlcd_splash_frame_len == DisplayLen && width_ == 400) {
+        memcpy(DispBuffer, rlcd_splash_frame, DisplayLen);
+        RLCD_Display();
+        return true;
+    }
     RLCD_ColorClear(ColorWhite);
+    return false;
 }
 
 void DisplayPort::RLCD_ColorClear(uint8_t color) {
@@ -201,6 +212,99 @@ void DisplayPort::RLCD_Display() {
 	RLCD_Sendbuffera(DispBuffer,DisplayLen);
 }
 
+// Panel memory is written page by page: a page is one byte row of DispBuffer
+// (two landscape columns, or two portrait rows) of 75 bytes, addressed in
+// column units of 3 bytes starting at 0x12. Round the area out to that grid.
+void DisplayPort::RLCD_AreaToWindow(int x1, int y1, int x2, int y2, int *p1, int *p2, int *b1, int *b2) {
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 >= width_) x2 = width_ - 1;
+    if (y2 >= height_) y2 = height_ - 1;
+
+    if (width_ == 400) {
+        *p1 = x1 >> 1;
+        *p2 = x2 >> 1;
+        *b1 = (height_ - 1 - y2) >> 2;
+        *b2 = (height_ - 1 - y1) >> 2;
+    } else {
+        *p1 = y1 >> 1;
+        *p2 = y2 >> 1;
+        *b1 = x1 >> 2;
+        *b2 = x2 >> 2;
+    }
+    *b1 = *b1 / 3 * 3;
+    *b2 = *b2 / 3 * 3 + 2;
+}
+
+void DisplayPort::RLCD_BackgroundClear() {
+    if (BackBuffer == NULL) {
+        BackBuffer = (uint8_t *) heap_caps_malloc(DisplayLen, MALLOC_CAP_SPIRAM);
+        assert(BackBuffer);
+    }
+    memset(BackBuffer, ColorWhite, DisplayLen);
+}
+
+void DisplayPort::RLCD_BlendBackground(int x1, int y1, int x2, int y2) {
+    if (BackBuffer == NULL || x1 > x2 || y1 > y2) {
+        return;
+    }
+    // Whole bytes: pixels of the window outside the area were blended by an
+    // earlier flush, and ANDing them again changes nothing
+    int p1, p2, b1, b2;
+    RLCD_AreaToWindow(x1, y1, x2, y2, &p1, &p2, &b1, &b2);
+    const int row = DisplayLen / (width_ == 400 ? width_ >> 1 : height_ >> 1);
+    for (int p = p1; p <= p2; p++) {
+        uint8_t       *dst = &DispBuffer[p * row];
+        const uint8_t *bg  = &BackBuffer[p * row];
+        for (int b = b1; b <= b2; b++) {
+            dst[b] &= bg[b];
+        }
+    }
+}
+
+void DisplayPort::RLCD_DisplayArea(int x1, int y1, int x2, int y2) {
+    if (x1 > x2 || y1 > y2) {
+        return;
+    }
+    int p1, p2, b1, b2;
+    RLCD_AreaToWindow(x1, y1, x2, y2, &p1, &p2, &b1, &b2);
+    const int row   = DisplayLen / (width_ == 400 ? width_ >> 1 : height_ >> 1);
+    const int width = b2 - b1 + 1;
+
+    RLCD_SendCommand(0x2A);     // Column Address Set
+  	RLCD_SendData(0x12 + b1 / 3);
+  	RLCD_SendData(0x12 + b2 / 3);
+
+  	RLCD_SendCommand(0x2B);     // Page Address Set
+  	RLCD_SendData(p1);
+  	RLCD_SendData(p2);
+
+  	RLCD_SendCommand(0x2c);     // Memory Write
+
+    // The commands above waited out the previous window's DMA, so the
+    // staging buffer is free again
+    uint8_t *out = WindowBuffer;
+    for (int p = p1; p <= p2; p++) {
+        memcpy(out, &DispBuffer[p * row + b1], width);
+        out += width;
+    }
+	RLCD_Sendbuffera(WindowBuffer, out - WindowBuffer);
+}
+
+void DisplayPort::RLCD_PrepareDeepSleep() {
+    Set_ResetIOLevel(1);
+    gpio_hold_en((gpio_num_t) rst_);
+    gpio_hold_en((gpio_num_t) cs_);
+    gpio_deep_sleep_hold_en();
+}
+
+void DisplayPort::RLCD_Resume() {
+    gpio_deep_sleep_hold_dis();
+    gpio_hold_dis((gpio_num_t) cs_);
+    gpio_hold_dis((gpio_num_t) rst_);
+    Set_ResetIOLevel(1);
+}
+
 void DisplayPort::RLCD_Reset(void) {
     Set_ResetIOLevel(1);
     vTaskDelay(pdMS_TO_TICKS(50));
@@ -366,6 +470,16 @@ void DisplayPort::RLCD_SetPixel(uint16_t x, uint16_t y, uint8_t color) {
         *p &= ~mask;
 }
 
+void DisplayPort::RLCD_SetBackgroundPixel(uint16_t x, uint16_t y, uint8_t color) {
+    uint8_t *p = &BackBuffer[PixelIndexLUT[x][y]];
+    uint8_t  mask = PixelBitLUT[x][y];
+
+    if (color)
+        *p |= mask;
+    else
+        *p &= ~mask;
+}
+
 #endif
 
 
@@ -28,6 +28,8 @@ private:
     int                 width_;
     int                 height_;
     uint8_t            *DispBuffer = NULL;
+    uint8_t            *BackBuffer = NULL;   // Packed static layer, 1 = white
+    uint8_t            *WindowBuffer = NULL; // Staging for RLCD_DisplayArea
     int                 DisplayLen;
 #if (AlgorithmOptimization == 3)
 	uint16_t (*PixelIndexLUT)[300];
@@ -41,18 +43,36 @@ private:
     void RLCD_SendData(uint8_t Data);
     void RLCD_Sendbuffera(uint8_t *Data, int len);
     void RLCD_Reset(void);
+    void RLCD_AreaToWindow(int x1, int y1, int x2, int y2, int *p1, int *p2, int *b1, int *b2);
 
 public:
     DisplayPort(int mosi, int scl, int dc, int cs, int rst, int width, int height, spi_host_device_t spihost = SPI3_HOST);
     ~DisplayPort();
-    void RLCD_Init();
+    bool RLCD_Init(); // true if the splash frame is on the panel
     void RLCD_ColorClear(uint8_t color);
     void RLCD_Display();
+
+    // Deep sleep with the image kept: latch RST/CS high so the controller is
+    // neither reset nor clocked while the SoC is off, and release them on
+    // wake instead of running RLCD_Init (which would blank the panel)
+    void RLCD_PrepareDeepSleep();
+    void RLCD_Resume();
+
+    // Compositing in the packed domain: the background plane holds the static
+    // layer, and every flushed area is ANDed with it (black wins) and sent as
+    // a panel window instead of a full frame
+    void RLCD_BackgroundClear();
+    void RLCD_BlendBackground(int x1, int y1, int x2, int y2);
+    void RLCD_DisplayArea(int x1, int y1, int x2, int y2);
+
+    uint8_t *RLCD_GetBuffer() { return DispBuffer; }
+    int RLCD_GetBufferLen() { return DisplayLen; }
 	#if (AlgorithmOptimization != 3)
     void RLCD_SetPortraitPixel(uint16_t x, uint16_t y, uint8_t color);      //竖屏显示
     void RLCD_SetLandscapePixel(uint16_t x, uint16_t y, uint8_t color);     //横屏显示
 	#endif
 	#if (AlgorithmOptimization == 3)
 	void RLCD_SetPixel(uint16_t x, uint16_t y, uint8_t color);
+	void RLCD_SetBackgroundPixel(uint16_t x, uint16_t y, uint8_t color);
 	#endif
 };
\ No newline at end of file
@@ -1,13 +1,126 @@
 #include <stdio.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "i2c_bsp.h"
 
-static uint32_t i2c_data_pdMS_TICKS = 0;
-static uint32_t i2c_done_pdMS_TICKS = 0;
+static const char *TAG = "i2c_bsp";
 
-I2cMasterBus::I2cMasterBus(int scl_pin,int sda_pin,int i2c_port) {
-    i2c_data_pdMS_TICKS = pdMS_TO_TICKS(5000);
-    i2c_done_pdMS_TICKS = pdMS_TO_TICKS(1000);
+typedef struct {
+    i2c_master_dev_handle_t dev;
+    uint16_t addr;
+    uint32_t count;
+    uint32_t bytes_written;
+    uint32_t bytes_read;
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint32_t errors;
+    uint64_t total_us;
+    uint32_t max_us;
+    uint32_t hist[I2C_TRACE_HIST_BUCKETS];
+} i2c_trace_dev_t;
+
+typedef struct {
+    uint32_t at_ms;
+    uint32_t dur_us;
+    uint16_t addr;
+    uint8_t  write_len;
+    uint8_t  read_len;
+    int16_t  ret;
+} i2c_trace_entry_t;
+
+struct I2cTraceState {
+    portMUX_TYPE      lock;
+    i2c_trace_dev_t   devs[I2C_TRACE_MAX_DEVICES];
+    i2c_trace_entry_t ring[I2C_TRACE_RING_LEN];
+    uint32_t          ring_next;
+};
+
+// Worst case per op: START, addr+W, reg, START, addr+R, READ (ACK), READ
+// (NACK); then one STOP
+#define I2C_BATCH_MAX_JOBS (I2C_MAX_BATCH_OPS * 7 + 1)
+// Both address bytes, the registers and the write data of a batch
+#define I2C_SLOT_DATA_LEN  (2 + I2C_MAX_BATCH_OPS + I2C_ASYNC_MAX_DATA)
+
+// One queued transaction; everything the driver points at lives here
+struct I2cAsyncSlot {
+    i2c_master_dev_handle_t dev;
+    i2c_done_cb_t           done_cb;
+    void                   *ctx;
+    uint32_t                sync_seq;  // Non-zero: a blocking helper waits on it
+    int64_t                 start_us;
+    uint8_t                 write_len;
+    uint8_t                 read_len;
+    uint8_t                 job_count; // Non-zero: a register batch
+    uint8_t                 data[I2C_SLOT_DATA_LEN];
+    uint8_t                 read[I2C_ASYNC_MAX_DATA];
+    i2c_operation_job_t     jobs[I2C_BATCH_MAX_JOBS];
+};
+
+typedef struct {
+    i2c_master_dev_handle_t dev;
+    uint16_t                addr;
+    bool                    async;
+} i2c_dev_entry_t;
+
+struct I2cAsyncState {
+    i2c_dev_entry_t   devs[I2C_MAX_DEVICES];
+    // The bus runs its queue in order, so in-flight slots form a ring whose
+    // head is the next to complete. head and used are shared with the ISR.
+    portMUX_TYPE      lock;
+    SemaphoreHandle_t submit_lock; // Keeps slot order equal to queue order
+    I2cAsyncSlot     *slots;
+    size_t            depth;
+    size_t            head;
+    size_t            used;
+    // Blocking helpers on a queued device wait here
+    SemaphoreHandle_t sync_lock;
+    SemaphoreHandle_t sync_sem;
+    uint32_t          sync_seq;
+    int               sync_ret;
+    uint8_t           sync_read[I2C_ASYNC_MAX_DATA];
+};
+
+// Bucket 0 is < 64 us, each following bucket doubles, the last is open ended
+static int i2c_trace_bucket(uint32_t us) {
+    int bucket = 0;
+    us >>= 6;
+    while (us && bucket < I2C_TRACE_HIST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+#if I2C_TRACE_ENABLE
+#define I2C_TRACE_BEGIN() int64_t trace_start_us = esp_timer_get_time()
+#define I2C_TRACE_END(dev, wlen, rlen, ret) i2c_trace_record(dev, wlen, rlen, trace_start_us, ret)
+#define I2C_TRACE_END_AT(dev, wlen, rlen, start_us, ret) i2c_trace_record(dev, wlen, rlen, start_us, ret)
+#define I2C_TRACE_END_ON(bus, dev, wlen, rlen, start_us, ret) (bus)->i2c_trace_record(dev, wlen, rlen, start_us, ret)
+#else
+#define I2C_TRACE_BEGIN()
+#define I2C_TRACE_END(dev, wlen, rlen, ret)
+#define I2C_TRACE_END_AT(dev, wlen, rlen, start_us, ret)
+#define I2C_TRACE_END_ON(bus, dev, wlen, rlen, start_us, ret)
+#endif
+
+I2cMasterBus::I2cMasterBus(int scl_pin,int sda_pin,int i2c_port,size_t trans_queue_depth) {
+    async_ = (I2cAsyncState *) calloc(1, sizeof(I2cAsyncState));
+    ESP_ERROR_CHECK(async_ ? ESP_OK : ESP_ERR_NO_MEM);
+    portMUX_INITIALIZE(&async_->lock);
+    if (trans_queue_depth) {
+        async_->slots       = (I2cAsyncSlot *) calloc(trans_queue_depth, sizeof(I2cAsyncSlot));
+        async_->submit_lock = xSemaphoreCreateMutex();
+        async_->sync_lock   = xSemaphoreCreateMutex();
+        async_->sync_sem    = xSemaphoreCreateBinary();
+        if (async_->slots && async_->submit_lock && async_->sync_lock && async_->sync_sem) {
+            async_->depth = trans_queue_depth;
+        } else {
+            ESP_LOGE(TAG, "No memory for %u queued transactions, staying synchronous", (unsigned) trans_queue_depth);
+        }
+    }
 
     i2c_master_bus_config_t i2c_bus_config      = {};
     i2c_bus_config.clk_source                   = I2C_CLK_SRC_DEFAULT;
@@ -15,59 +128,570 @@ I2cMasterBus::I2cMasterBus(int scl_pin,int sda_pin,int i2c_port) {
     i2c_bus_config.scl_io_num                   = (gpio_num_t)scl_pin;
     i2c_bus_config.sda_io_num                   = (gpio_num_t)sda_pin;
     i2c_bus_config.glitch_ignore_cnt            = 7;
+    i2c_bus_config.trans_queue_depth            = async_->depth;
     i2c_bus_config.flags.enable_internal_pullup = true;
     ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_bus_config, &user_i2c_handle));
+
+#if I2C_TRACE_ENABLE
+    trace_ = (I2cTraceState *) calloc(1, sizeof(I2cTraceState));
+    if (trace_) {
+        portMUX_INITIALIZE(&trace_->lock);
+    }
+#endif
 }
 
 I2cMasterBus::~I2cMasterBus() {
+    free(trace_);
+    if (async_->submit_lock) {
+        vSemaphoreDelete(async_->submit_lock);
+    }
+    if (async_->sync_lock) {
+        vSemaphoreDelete(async_->sync_lock);
+    }
+    if (async_->sync_sem) {
+        vSemaphoreDelete(async_->sync_sem);
+    }
+    free(async_->slots);
+    free(async_);
+}
 
+i2c_master_dev_handle_t I2cMasterBus::i2c_add_device(uint16_t dev_addr, uint32_t scl_speed_hz) {
+    i2c_master_dev_handle_t dev_handle = NULL;
+    i2c_device_config_t     dev_cfg    = {};
+    dev_cfg.dev_addr_length            = I2C_ADDR_BIT_LEN_7;
+    dev_cfg.device_address             = dev_addr;
+    dev_cfg.scl_speed_hz               = scl_speed_hz;
+    ESP_ERROR_CHECK(i2c_master_bus_add_device(user_i2c_handle, &dev_cfg, &dev_handle));
+
+    for (int i = 0; i < I2C_MAX_DEVICES; i++) {
+        if (async_->devs[i].dev == NULL) {
+            async_->devs[i].dev  = dev_handle;
+            async_->devs[i].addr = dev_addr;
+            break;
+        }
+    }
+
+    if (trace_) {
+        portENTER_CRITICAL(&trace_->lock);
+        for (int i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+            if (trace_->devs[i].dev == NULL) {
+                trace_->devs[i].dev  = dev_handle;
+                trace_->devs[i].addr = dev_addr;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&trace_->lock);
+    }
+    return dev_handle;
 }
 
-int I2cMasterBus::i2c_write_buff(i2c_master_dev_handle_t dev_handle, int reg, uint8_t *buf, uint8_t len) {
-    int  ret;
-    uint8_t *pbuf = NULL;
-    ret           = i2c_master_bus_wait_all_done(user_i2c_handle, i2c_done_pdMS_TICKS);
-    if (ret != ESP_OK)
-        return ret;
-    if (reg == -1) {
-        ret = i2c_master_transmit(dev_handle, buf, len, i2c_data_pdMS_TICKS);
-    } else {
-        pbuf    = (uint8_t *) malloc(len + 1);
-        pbuf[0] = reg;
-        for (uint8_t i = 0; i < len; i++) {
-            pbuf[i + 1] = buf[i];
+int I2cMasterBus::i2c_enable_async(i2c_master_dev_handle_t dev_handle) {
+    if (!async_->depth) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    i2c_dev_entry_t *entry = NULL;
+    for (int i = 0; i < I2C_MAX_DEVICES; i++) {
+        if (async_->devs[i].dev == dev_handle) {
+            entry = &async_->devs[i];
+            break;
         }
-        ret = i2c_master_transmit(dev_handle, pbuf, len + 1, i2c_data_pdMS_TICKS);
-        free(pbuf);
-        pbuf = NULL;
+    }
+    if (!entry) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_master_event_callbacks_t cbs = {};
+    cbs.on_trans_done                = i2c_async_done;
+    int ret = i2c_master_register_event_callbacks(dev_handle, &cbs, this);
+    if (ret == ESP_OK) {
+        entry->async = true;
     }
     return ret;
 }
 
-int I2cMasterBus::i2c_master_write_read_dev(i2c_master_dev_handle_t dev_handle, uint8_t *writeBuf, uint8_t writeLen, uint8_t *readBuf, uint8_t readLen) {
+bool I2cMasterBus::i2c_is_async(i2c_master_dev_handle_t dev_handle) {
+    for (int i = 0; i < I2C_MAX_DEVICES; i++) {
+        if (async_->devs[i].dev == dev_handle) {
+            return async_->devs[i].async;
+        }
+    }
+    return false;
+}
+
+void I2cMasterBus::i2c_trace_record(i2c_master_dev_handle_t dev_handle, size_t writeLen, size_t readLen, int64_t start_us, int ret) {
+    if (!trace_) {
+        return;
+    }
+    int64_t  now_us = esp_timer_get_time();
+    uint32_t dur_us = (uint32_t)(now_us - start_us);
+
+    // Also called from the done ISR for queued transactions
+    portENTER_CRITICAL_SAFE(&trace_->lock);
+    i2c_trace_dev_t *dev = NULL;
+    for (int i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        if (trace_->devs[i].dev == dev_handle) {
+            dev = &trace_->devs[i];
+            break;
+        }
+    }
+    if (dev) {
+        dev->count++;
+        dev->bytes_written += writeLen;
+        dev->bytes_read += readLen;
+        dev->total_us += dur_us;
+        if (dur_us > dev->max_us) {
+            dev->max_us = dur_us;
+        }
+        dev->hist[i2c_trace_bucket(dur_us)]++;
+        if (ret == ESP_ERR_TIMEOUT) {
+            dev->timeouts++;
+        } else if (ret == ESP_ERR_INVALID_STATE || ret == ESP_ERR_INVALID_RESPONSE) {
+            dev->nacks++; // The driver reports an unexpected NACK as one of these
+        } else if (ret != ESP_OK) {
+            dev->errors++;
+        }
+    }
+
+    i2c_trace_entry_t *entry = &trace_->ring[trace_->ring_next % I2C_TRACE_RING_LEN];
+    entry->at_ms             = (uint32_t)(start_us / 1000);
+    entry->dur_us            = dur_us;
+    entry->addr              = dev ? dev->addr : 0xFFFF;
+    entry->write_len         = writeLen > 255 ? 255 : writeLen;
+    entry->read_len          = readLen > 255 ? 255 : readLen;
+    entry->ret               = (int16_t) ret;
+    trace_->ring_next++;
+    portEXIT_CRITICAL_SAFE(&trace_->lock);
+}
+
+// Lay out a register batch in a slot: addresses, registers and write data
+// are copied into slot->data, reads land in slot->read
+static int i2c_build_reg_ops(I2cAsyncSlot *slot, uint16_t dev_addr, const i2c_reg_op_t *ops, size_t count) {
+    if (count == 0 || count > I2C_MAX_BATCH_OPS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t *addr_w = &slot->data[0];
+    uint8_t *addr_r = &slot->data[1];
+    *addr_w         = (uint8_t)(dev_addr << 1);
+    *addr_r         = *addr_w | 1;
+    size_t pos      = 2;
+    size_t read_pos = 0;
+    size_t n        = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const i2c_reg_op_t *op = &ops[i];
+        bool has_reg           = op->reg != -1;
+
+        if (has_reg || !op->is_read) {
+            slot->jobs[n].command           = I2C_MASTER_CMD_START;
+            n++;
+            slot->jobs[n].command           = I2C_MASTER_CMD_WRITE;
+            slot->jobs[n].write.ack_check   = true;
+            slot->jobs[n].write.data        = addr_w;
+            slot->jobs[n].write.total_bytes = 1;
+            n++;
+        }
+        if (has_reg) {
+            slot->data[pos]                 = (uint8_t) op->reg;
+            slot->jobs[n].command           = I2C_MASTER_CMD_WRITE;
+            slot->jobs[n].write.ack_check   = true;
+            slot->jobs[n].write.data        = &slot->data[pos];
+            slot->jobs[n].write.total_bytes = 1;
+            pos++;
+            n++;
+        }
+
+        if (!op->is_read) {
+            if (op->len) {
+                if (pos + op->len > I2C_SLOT_DATA_LEN) {
+                    return ESP_ERR_INVALID_SIZE;
+                }
+                memcpy(&slot->data[pos], op->buf, op->len);
+                slot->jobs[n].command           = I2C_MASTER_CMD_WRITE;
+                slot->jobs[n].write.ack_check   = true;
+                slot->jobs[n].write.data        = &slot->data[pos];
+                slot->jobs[n].write.total_bytes = op->len;
+                pos += op->len;
+                n++;
+            }
+            continue;
+        }
+
+        if (op->len == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (read_pos + op->len > I2C_ASYNC_MAX_DATA) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        slot->jobs[n].command           = I2C_MASTER_CMD_START;
+        n++;
+        slot->jobs[n].command           = I2C_MASTER_CMD_WRITE;
+        slot->jobs[n].write.ack_check   = true;
+        slot->jobs[n].write.data        = addr_r;
+        slot->jobs[n].write.total_bytes = 1;
+        n++;
+        if (op->len > 1) {
+            slot->jobs[n].command          = I2C_MASTER_CMD_READ;
+            slot->jobs[n].read.ack_value   = I2C_ACK_VAL;
+            slot->jobs[n].read.data        = &slot->read[read_pos];
+            slot->jobs[n].read.total_bytes = op->len - 1;
+            n++;
+        }
+        // The last byte of a read must be NACKed
+        slot->jobs[n].command          = I2C_MASTER_CMD_READ;
+        slot->jobs[n].read.ack_value   = I2C_NACK_VAL;
+        slot->jobs[n].read.data        = &slot->read[read_pos + op->len - 1];
+        slot->jobs[n].read.total_bytes = 1;
+        read_pos += op->len;
+        n++;
+    }
+    slot->jobs[n].command = I2C_MASTER_CMD_STOP;
+    n++;
+
+    slot->job_count = n;
+    slot->write_len = pos - 2;
+    slot->read_len  = read_pos;
+    return ESP_OK;
+}
+
+// Next free slot, or NULL if all are in flight. Called with submit_lock held.
+I2cAsyncSlot *I2cMasterBus::i2c_slot_reserve() {
+    I2cAsyncSlot *slot = NULL;
+    portENTER_CRITICAL(&async_->lock);
+    if (async_->used < async_->depth) {
+        slot = &async_->slots[(async_->head + async_->used) % async_->depth];
+    }
+    portEXIT_CRITICAL(&async_->lock);
+    if (slot) {
+        slot->done_cb   = NULL;
+        slot->ctx       = NULL;
+        slot->sync_seq  = 0;
+        slot->write_len = 0;
+        slot->read_len  = 0;
+        slot->job_count = 0;
+    }
+    return slot;
+}
+
+// Hand a filled slot to the driver's queue. Called with submit_lock held.
+int I2cMasterBus::i2c_slot_submit(I2cAsyncSlot *slot) {
+    // Count it first: the done ISR can fire before the driver call returns
+    slot->start_us = esp_timer_get_time();
+    portENTER_CRITICAL(&async_->lock);
+    async_->used++;
+    portEXIT_CRITICAL(&async_->lock);
+
     int ret;
-    ret = i2c_master_bus_wait_all_done(user_i2c_handle, i2c_done_pdMS_TICKS);
-    if (ret != ESP_OK)
-        return ret;
-    ret = i2c_master_transmit_receive(dev_handle, writeBuf, writeLen, readBuf, readLen, i2c_data_pdMS_TICKS);
+    if (slot->job_count) {
+        ret = i2c_master_execute_defined_operations(slot->dev, slot->jobs, slot->job_count, I2C_XFER_TIMEOUT_MS);
+    } else if (slot->write_len && slot->read_len) {
+        ret = i2c_master_transmit_receive(slot->dev, slot->data, slot->write_len, slot->read, slot->read_len, I2C_XFER_TIMEOUT_MS);
+    } else if (slot->write_len) {
+        ret = i2c_master_transmit(slot->dev, slot->data, slot->write_len, I2C_XFER_TIMEOUT_MS);
+    } else {
+        ret = i2c_master_receive(slot->dev, slot->read, slot->read_len, I2C_XFER_TIMEOUT_MS);
+    }
+
+    if (ret != ESP_OK) {
+        // Not queued, so no completion will come; it is still the newest slot
+        portENTER_CRITICAL(&async_->lock);
+        async_->used--;
+        portEXIT_CRITICAL(&async_->lock);
+        I2C_TRACE_END_AT(slot->dev, slot->write_len, slot->read_len, slot->start_us, ret);
+    }
     return ret;
 }
 
-int I2cMasterBus::i2c_read_buff(i2c_master_dev_handle_t dev_handle, int reg, uint8_t *buf, uint8_t len) {
-    int ret;
-    uint8_t addr = 0;
-    ret          = i2c_master_bus_wait_all_done(user_i2c_handle, i2c_done_pdMS_TICKS);
-    if (ret != ESP_OK)
-        return ret;
-    if (reg == -1) {
-        ret = i2c_master_receive(dev_handle, buf, len, i2c_data_pdMS_TICKS);
+bool I2cMasterBus::i2c_async_done(i2c_master_dev_handle_t dev_handle, const i2c_master_event_data_t *evt, void *arg) {
+    I2cMasterBus  *bus = (I2cMasterBus *) arg;
+    I2cAsyncState *as  = bus->async_;
+    if (evt->event == I2C_EVENT_ALIVE) {
+        return false;
+    }
+
+    portENTER_CRITICAL_ISR(&as->lock);
+    I2cAsyncSlot *slot = as->used ? &as->slots[as->head] : NULL;
+    portEXIT_CRITICAL_ISR(&as->lock);
+    if (!slot) {
+        return false;
+    }
+
+    int ret = evt->event == I2C_EVENT_DONE      ? ESP_OK
+              : evt->event == I2C_EVENT_TIMEOUT ? ESP_ERR_TIMEOUT
+                                                : ESP_ERR_INVALID_RESPONSE;
+    // Includes the time spent waiting in the queue
+    I2C_TRACE_END_ON(bus, dev_handle, slot->write_len, slot->read_len, slot->start_us, ret);
+
+    BaseType_t woken = pdFALSE;
+    if (slot->sync_seq) {
+        // Checked and given under the lock, so a waiter that timed out and
+        // moved on is never woken by its late completion
+        portENTER_CRITICAL_ISR(&as->lock);
+        if (slot->sync_seq == as->sync_seq) {
+            as->sync_ret = ret;
+            memcpy(as->sync_read, slot->read, slot->read_len);
+            xSemaphoreGiveFromISR(as->sync_sem, &woken);
+        }
+        portEXIT_CRITICAL_ISR(&as->lock);
+    } else if (slot->done_cb) {
+        woken = slot->done_cb(ret, slot->read, slot->read_len, slot->ctx) ? pdTRUE : pdFALSE;
+    }
+
+    portENTER_CRITICAL_ISR(&as->lock);
+    as->head = (as->head + 1) % as->depth;
+    as->used--;
+    portEXIT_CRITICAL_ISR(&as->lock);
+    return woken == pdTRUE;
+}
+
+// Blocking transfer on a queued device: submit, then wait for the ISR
+int I2cMasterBus::i2c_xfer_queued(i2c_master_dev_handle_t dev_handle, int reg, const uint8_t *writeBuf, size_t writeLen, uint8_t *readBuf, size_t readLen) {
+    I2cAsyncState *as  = async_;
+    size_t         out = writeLen + (reg != -1 ? 1 : 0);
+    if (out > I2C_ASYNC_MAX_DATA || readLen > I2C_ASYNC_MAX_DATA) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    xSemaphoreTake(as->sync_lock, portMAX_DELAY);
+    portENTER_CRITICAL(&as->lock);
+    uint32_t seq = ++as->sync_seq;
+    if (seq == 0) {
+        seq = ++as->sync_seq;
+    }
+    portEXIT_CRITICAL(&as->lock);
+    // Drop a completion that landed after an earlier caller gave up
+    xSemaphoreTake(as->sync_sem, 0);
+
+    int ret = ESP_ERR_NO_MEM;
+    for (int attempt = 0; attempt < 2 && ret == ESP_ERR_NO_MEM; attempt++) {
+        if (attempt) {
+            // Every slot is in flight; let the queue drain once
+            i2c_master_bus_wait_all_done(user_i2c_handle, I2C_XFER_TIMEOUT_MS);
+        }
+        xSemaphoreTake(as->submit_lock, portMAX_DELAY);
+        I2cAsyncSlot *slot = i2c_slot_reserve();
+        if (slot) {
+            slot->dev       = dev_handle;
+            slot->sync_seq  = seq;
+            slot->write_len = out;
+            slot->read_len  = readLen;
+            if (reg != -1) {
+                slot->data[0] = (uint8_t) reg;
+            }
+            if (writeLen) {
+                memcpy(&slot->data[out - writeLen], writeBuf, writeLen);
+            }
+            ret = i2c_slot_submit(slot);
+        }
+        xSemaphoreGive(as->submit_lock);
+    }
+
+    if (ret == ESP_OK) {
+        // Each transaction queued ahead may use its full timeout
+        if (xSemaphoreTake(as->sync_sem, pdMS_TO_TICKS(I2C_XFER_TIMEOUT_MS * (as->depth + 1))) == pdTRUE) {
+            ret = as->sync_ret;
+            if (ret == ESP_OK && readLen) {
+                memcpy(readBuf, as->sync_read, readLen);
+            }
+        } else {
+            ret = ESP_ERR_TIMEOUT;
+        }
+    }
+    xSemaphoreGive(as->sync_lock);
+    return ret;
+}
+
+// Core of the blocking helpers
+int I2cMasterBus::i2c_xfer(i2c_master_dev_handle_t dev_handle, int reg, const uint8_t *writeBuf, size_t writeLen, uint8_t *readBuf, size_t readLen) {
+    if (i2c_is_async(dev_handle)) {
+        return i2c_xfer_queued(dev_handle, reg, writeBuf, writeLen, readBuf, readLen);
+    }
+
+    int     ret;
+    uint8_t addr = (uint8_t) reg;
+    I2C_TRACE_BEGIN();
+    if (reg != -1 && writeLen) {
+        // Register byte and payload go out as one transaction without copying
+        i2c_master_transmit_multi_buffer_info_t parts[2] = {
+            {.write_buffer = &addr, .buffer_size = 1},
+            {.write_buffer = (uint8_t *) writeBuf, .buffer_size = writeLen},
+        };
+        ret = i2c_master_multi_buffer_transmit(dev_handle, parts, 2, I2C_XFER_TIMEOUT_MS);
+        writeLen++;
     } else {
-        addr = (uint8_t) reg;
-        ret  = i2c_master_transmit_receive(dev_handle, &addr, 1, buf, len, i2c_data_pdMS_TICKS);
+        if (reg != -1) {
+            writeBuf = &addr;
+            writeLen = 1;
+        }
+        if (writeLen && readLen) {
+            ret = i2c_master_transmit_receive(dev_handle, writeBuf, writeLen, readBuf, readLen, I2C_XFER_TIMEOUT_MS);
+        } else if (writeLen) {
+            ret = i2c_master_transmit(dev_handle, writeBuf, writeLen, I2C_XFER_TIMEOUT_MS);
+        } else if (readLen) {
+            ret = i2c_master_receive(dev_handle, readBuf, readLen, I2C_XFER_TIMEOUT_MS);
+        } else {
+            ret = ESP_ERR_INVALID_ARG;
+        }
     }
+    I2C_TRACE_END(dev_handle, writeLen, readLen, ret);
     return ret;
 }
 
+int I2cMasterBus::i2c_write_buff(i2c_master_dev_handle_t dev_handle, int reg, uint8_t *buf, uint8_t len) {
+    return i2c_xfer(dev_handle, reg, buf, len, NULL, 0);
+}
+
+int I2cMasterBus::i2c_master_write_read_dev(i2c_master_dev_handle_t dev_handle, uint8_t *writeBuf, uint8_t writeLen, uint8_t *readBuf, uint8_t readLen) {
+    return i2c_xfer(dev_handle, -1, writeBuf, writeLen, readBuf, readLen);
+}
+
+int I2cMasterBus::i2c_read_buff(i2c_master_dev_handle_t dev_handle, int reg, uint8_t *buf, uint8_t len) {
+    return i2c_xfer(dev_handle, reg, NULL, 0, buf, len);
+}
+
+int I2cMasterBus::i2c_submit(i2c_master_dev_handle_t dev_handle, const uint8_t *writeBuf, size_t writeLen, size_t readLen, i2c_done_cb_t done_cb, void *ctx) {
+    if (writeLen > I2C_ASYNC_MAX_DATA || readLen > I2C_ASYNC_MAX_DATA) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (!writeLen && !readLen) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!i2c_is_async(dev_handle)) {
+        uint8_t read[I2C_ASYNC_MAX_DATA];
+        int     ret = i2c_xfer(dev_handle, -1, writeBuf, writeLen, read, readLen);
+        if (done_cb) {
+            done_cb(ret, read, readLen, ctx);
+        }
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(async_->submit_lock, portMAX_DELAY);
+    I2cAsyncSlot *slot = i2c_slot_reserve();
+    int           ret  = ESP_ERR_NO_MEM;
+    if (slot) {
+        slot->dev       = dev_handle;
+        slot->done_cb   = done_cb;
+        slot->ctx       = ctx;
+        slot->write_len = writeLen;
+        slot->read_len  = readLen;
+        if (writeLen) {
+            memcpy(slot->data, writeBuf, writeLen);
+        }
+        ret = i2c_slot_submit(slot);
+    }
+    xSemaphoreGive(async_->submit_lock);
+    return ret;
+}
+
+int I2cMasterBus::i2c_submit_reg_ops(i2c_master_dev_handle_t dev_handle, const i2c_reg_op_t *ops, size_t count, i2c_done_cb_t done_cb, void *ctx) {
+    uint16_t dev_addr = 0;
+    for (int i = 0; i < I2C_MAX_DEVICES; i++) {
+        if (async_->devs[i].dev == dev_handle) {
+            dev_addr = async_->devs[i].addr;
+            break;
+        }
+    }
+    if (!dev_addr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!i2c_is_async(dev_handle)) {
+        // Not queued, so the job list can live on this stack
+        I2cAsyncSlot slot;
+        int          ret = i2c_build_reg_ops(&slot, dev_addr, ops, count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        I2C_TRACE_BEGIN();
+        ret = i2c_master_execute_defined_operations(dev_handle, slot.jobs, slot.job_count, I2C_XFER_TIMEOUT_MS);
+        I2C_TRACE_END(dev_handle, slot.write_len, slot.read_len, ret);
+        if (done_cb) {
+            done_cb(ret, slot.read, slot.read_len, ctx);
+        }
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(async_->submit_lock, portMAX_DELAY);
+    I2cAsyncSlot *slot = i2c_slot_reserve();
+    int           ret  = ESP_ERR_NO_MEM;
+    if (slot) {
+        slot->dev     = dev_handle;
+        slot->done_cb = done_cb;
+        slot->ctx     = ctx;
+        ret           = i2c_build_reg_ops(slot, dev_addr, ops, count);
+        if (ret == ESP_OK) {
+            ret = i2c_slot_submit(slot);
+        }
+    }
+    xSemaphoreGive(async_->submit_lock);
+    return ret;
+}
+
+int I2cMasterBus::i2c_wait_idle(int timeout_ms) {
+    return i2c_master_bus_wait_all_done(user_i2c_handle, timeout_ms);
+}
+
+void I2cMasterBus::i2c_trace_dump() {
+    if (!trace_) {
+        ESP_LOGI(TAG, "I2C trace disabled (I2C_TRACE_ENABLE)");
+        return;
+    }
+
+    // Copy under the lock, log outside it
+    I2cTraceState *copy = (I2cTraceState *) malloc(sizeof(I2cTraceState));
+    if (!copy) {
+        return;
+    }
+    portENTER_CRITICAL(&trace_->lock);
+    memcpy(copy, trace_, sizeof(I2cTraceState));
+    portEXIT_CRITICAL(&trace_->lock);
+
+    for (int i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        const i2c_trace_dev_t *dev = &copy->devs[i];
+        if (!dev->dev) {
+            continue;
+        }
+        ESP_LOGI(TAG, "0x%02x: %lu xfers, %lu B out, %lu B in, avg %lu us, max %lu us, nack %lu, timeout %lu, err %lu",
+                 dev->addr, (unsigned long) dev->count, (unsigned long) dev->bytes_written,
+                 (unsigned long) dev->bytes_read,
+                 (unsigned long) (dev->count ? dev->total_us / dev->count : 0),
+                 (unsigned long) dev->max_us, (unsigned long) dev->nacks,
+                 (unsigned long) dev->timeouts, (unsigned long) dev->errors);
+
+        char line[I2C_TRACE_HIST_BUCKETS * 11 + 1];
+        int  pos = 0;
+        for (int b = 0; b < I2C_TRACE_HIST_BUCKETS; b++) {
+            pos += snprintf(line + pos, sizeof(line) - pos, " %lu", (unsigned long) dev->hist[b]);
+        }
+        ESP_LOGI(TAG, "0x%02x: latency histogram (64us << n):%s", dev->addr, line);
+    }
+
+    uint32_t total = copy->ring_next < I2C_TRACE_RING_LEN ? copy->ring_next : I2C_TRACE_RING_LEN;
+    ESP_LOGI(TAG, "Last %lu transactions (oldest first):", (unsigned long) total);
+    for (uint32_t i = copy->ring_next - total; i != copy->ring_next; i++) {
+        const i2c_trace_entry_t *e = &copy->ring[i % I2C_TRACE_RING_LEN];
+        ESP_LOGI(TAG, "  %8lu ms 0x%02x w%u r%u %6lu us %s", (unsigned long) e->at_ms, e->addr,
+                 e->write_len, e->read_len, (unsigned long) e->dur_us, esp_err_to_name(e->ret));
+    }
+    free(copy);
+}
+
+void I2cMasterBus::i2c_trace_reset() {
+    if (!trace_) {
+        return;
+    }
+    portENTER_CRITICAL(&trace_->lock);
+    for (int i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        i2c_trace_dev_t *dev = &trace_->devs[i];
+        i2c_master_dev_handle_t handle = dev->dev;
+        uint16_t addr                  = dev->addr;
+        memset(dev, 0, sizeof(*dev));
+        dev->dev  = handle;
+        dev->addr = addr;
+    }
+    trace_->ring_next = 0;
+    portEXIT_CRITICAL(&trace_->lock);
+}
+
 i2c_master_bus_handle_t I2cMasterBus::Get_I2cBusHandle() {
     return user_i2c_handle;
-}
\ No newline at end of file
+}
@@ -3,18 +3,92 @@
 
 #include <driver/i2c_master.h>
 
+#define I2C_XFER_TIMEOUT_MS 100 // A few bytes at 400 kHz take well under 1 ms
+
+// Queued transactions: the data lives in bus-owned slots (one per queue
+// entry, allocated with the bus), so submitters never keep buffers alive
+#define I2C_ASYNC_MAX_DATA      16 // Bytes written, and read, per transaction
+#define I2C_MAX_BATCH_OPS       4
+#define I2C_MAX_DEVICES         8
+
+// One register access in a batch (see i2c_submit_reg_ops)
+typedef struct {
+    int            reg;     // register address, -1 for none
+    const uint8_t *buf;     // data to write, copied on submit; unused for reads
+    uint8_t        len;
+    bool           is_read;
+} i2c_reg_op_t;
+
+// Completion of a submitted transaction, run from the I2C ISR (or in the
+// submitting task on a device without async). read holds the bytes read,
+// every read of a batch in order, and is only valid during the call.
+// Returns true if it woke a higher priority task.
+typedef bool (*i2c_done_cb_t)(int ret,const uint8_t *read,size_t readLen,void *ctx);
+
+// Per-device transaction statistics and a ring of recent transactions,
+// printed with i2c_trace_dump() alongside the dashboard's periodic stats.
+// Costs ~2 KB of RAM and a timestamp pair per transaction when enabled.
+#define I2C_TRACE_ENABLE        0
+#define I2C_TRACE_MAX_DEVICES   8
+#define I2C_TRACE_RING_LEN      64
+#define I2C_TRACE_HIST_BUCKETS  12 // <64us, <128us, ... , >=65ms
+
+struct I2cTraceState;
+struct I2cAsyncState;
+struct I2cAsyncSlot;
+
 class I2cMasterBus
 {
 private:
     i2c_master_bus_handle_t user_i2c_handle = NULL;
+    I2cTraceState *trace_ = NULL;
+    I2cAsyncState *async_ = NULL;
+
+    void i2c_trace_record(i2c_master_dev_handle_t dev_handle,size_t writeLen,size_t readLen,int64_t start_us,int ret);
+    bool i2c_is_async(i2c_master_dev_handle_t dev_handle);
+    int i2c_xfer(i2c_master_dev_handle_t dev_handle,int reg,const uint8_t *writeBuf,size_t writeLen,uint8_t *readBuf,size_t readLen);
+    int i2c_xfer_queued(i2c_master_dev_handle_t dev_handle,int reg,const uint8_t *writeBuf,size_t writeLen,uint8_t *readBuf,size_t readLen);
+    I2cAsyncSlot *i2c_slot_reserve();
+    int i2c_slot_submit(I2cAsyncSlot *slot);
+    static bool i2c_async_done(i2c_master_dev_handle_t dev_handle,const i2c_master_event_data_t *evt,void *arg);
 public:
-    I2cMasterBus(int scl_pin,int sda_pin,int i2c_port);
+    // trans_queue_depth > 0 enables the driver's queued mode for devices
+    // set up with i2c_enable_async(), with that many transactions in flight
+    I2cMasterBus(int scl_pin,int sda_pin,int i2c_port,size_t trans_queue_depth = 0);
     ~I2cMasterBus();
 
+    // Adds a device to the bus; the address is kept for batches and tracing
+    i2c_master_dev_handle_t i2c_add_device(uint16_t dev_addr,uint32_t scl_speed_hz);
+
+    // Queue this device's transactions instead of running them in the
+    // caller. The blocking helpers still work on it: they submit and wait.
+    int i2c_enable_async(i2c_master_dev_handle_t dev_handle);
+
+    // Blocking helpers; no heap allocation
     int i2c_write_buff(i2c_master_dev_handle_t dev_handle,int reg,uint8_t *buf,uint8_t len);
     int i2c_master_write_read_dev(i2c_master_dev_handle_t dev_handle,uint8_t *writeBuf,uint8_t writeLen,uint8_t *readBuf,uint8_t readLen);
     int i2c_read_buff(i2c_master_dev_handle_t dev_handle,int reg,uint8_t *buf,uint8_t len);
+
+    // Write then read (either length may be 0). The write is copied and the
+    // read lands in a bus-owned buffer passed to done_cb (may be NULL), so
+    // nothing the caller owns has to outlive the call. Returns once queued,
+    // or ESP_ERR_NO_MEM if every slot is in flight; on a device without
+    // async it runs to completion and calls done_cb before returning.
+    int i2c_submit(i2c_master_dev_handle_t dev_handle,const uint8_t *writeBuf,size_t writeLen,size_t readLen,i2c_done_cb_t done_cb,void *ctx);
+
+    // Up to I2C_MAX_BATCH_OPS register accesses on one device as a single
+    // submission joined by repeated starts; queued like i2c_submit
+    int i2c_submit_reg_ops(i2c_master_dev_handle_t dev_handle,const i2c_reg_op_t *ops,size_t count,i2c_done_cb_t done_cb,void *ctx);
+
+    // Wait for every queued transaction to finish
+    int i2c_wait_idle(int timeout_ms);
+
+    // Log per-device statistics and the recent transaction ring (no-op
+    // unless I2C_TRACE_ENABLE)
+    void i2c_trace_dump();
+    void i2c_trace_reset();
+
     i2c_master_bus_handle_t Get_I2cBusHandle();
 };
 
-#endif
\ No newline at end of file
+#endif
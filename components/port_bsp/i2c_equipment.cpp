@@ -1,24 +1,21 @@
 #include <stdio.h>
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
+#include <esp_rom_sys.h>
 #include "i2c_equipment.h"
 #include "i2c_bsp.h"
 #include "SensorPCF85063.hpp"
 
 Shtc3Port::Shtc3Port(I2cMasterBus& i2cbus) :
 i2cbus_(i2cbus) {
-    i2c_master_bus_handle_t I2cMasterBus = i2cbus_.Get_I2cBusHandle();
-    i2c_device_config_t dev_cfg = {};
-    dev_cfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
-    dev_cfg.device_address  = Shtc3Address;
-    dev_cfg.scl_speed_hz    = 400000;
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(I2cMasterBus, &dev_cfg, &I2c_DevShtc3));
+    I2c_DevShtc3 = i2cbus_.i2c_add_device(Shtc3Address, 400000);
 
     Shtc3_Wakeup();
     Shtc3_SoftReset();
     vTaskDelay(pdMS_TO_TICKS(20)); //20MS
     Shtc3_GetId();
     ESP_LOGI(TAG, "ID:%04x", shtc3_id);
+    Shtc3_Sleep();
 }
 
 Shtc3Port::~Shtc3Port() {
@@ -51,8 +48,7 @@ etError Shtc3Port::Shtc3_Wakeup() {
     uint8_t senBuf[2] = {(WAKEUP >> 8), (WAKEUP & 0xff)};
     int     err       = i2cbus_.i2c_write_buff(I2c_DevShtc3, -1, senBuf, 2);
     etError error     = (err == ESP_OK) ? NO_ERROR : ACK_ERROR;
-    //esp_rom_delay_us(100); //100us
-    vTaskDelay(pdMS_TO_TICKS(50)); //50MS
+    esp_rom_delay_us(SHTC3_WAKEUP_US);
     if (error != NO_ERROR)
         ESP_LOGE("shtc3", "Wakeup Failure");
     return error;
@@ -95,7 +91,7 @@ etError Shtc3Port::Shtc3_CheckCrc(uint8_t data[], uint8_t nbrOfBytes, uint8_t ch
 float Shtc3Port::Shtc3_CalcTemperature(uint16_t rawValue) {
     // calculate temperature [°C]
     // T = -45 + 175 * rawValue / 2^16
-    return 175 * (float) rawValue / 65536.0f - 45.0f - SHTC3_PETP_VOL;
+    return 175 * (float) rawValue / 65536.0f - 45.0f - temp_offset;
 }
 
 float Shtc3Port::Shtc3_CalcHumidity(uint16_t rawValue) {
@@ -104,31 +100,67 @@ float Shtc3Port::Shtc3_CalcHumidity(uint16_t rawValue) {
     return 100 * (float) rawValue / 65536.0f;
 }
 
-etError Shtc3Port::Shtc3_GetTempAndHumiPolling(float *temp, float *humi) {
-    int      err = 0;
-    etError  error;        // error code
-    uint16_t rawValueTemp; // temperature raw value from sensor
-    uint16_t rawValueHumi; // humidity raw value from sensor
-    uint8_t  bytes[6] = {0};
-    ;
-    uint8_t senBuf[2] = {(MEAS_T_RH_POLLING >> 8), (MEAS_T_RH_POLLING & 0xff)};
-    err               = i2cbus_.i2c_write_buff(I2c_DevShtc3, -1, senBuf, 2);
-    error             = (err == ESP_OK) ? NO_ERROR : ACK_ERROR;
+void Shtc3Port::Shtc3_SetLowPower(bool enable) {
+    low_power = enable;
+}
+
+void Shtc3Port::Shtc3_SetTempOffset(float offset) {
+    temp_offset = offset;
+}
+
+uint32_t Shtc3Port::Shtc3_MeasTimeUs() {
+    return low_power ? SHTC3_MEAS_LP_US : SHTC3_MEAS_US;
+}
+
+etError Shtc3Port::Shtc3_StartMeasurement() {
+    etError error = Shtc3_Wakeup();
     if (error != NO_ERROR) {
-        ESP_LOGE("shtc3", "GetTempAndHumi WRITE Failure");
         return error;
     }
 
-    vTaskDelay(pdMS_TO_TICKS(20));
+    uint16_t cmd      = low_power ? MEAS_T_RH_POLLING_LP : MEAS_T_RH_POLLING;
+    uint8_t senBuf[2] = {(uint8_t)(cmd >> 8), (uint8_t)(cmd & 0xff)};
+    int err           = i2cbus_.i2c_write_buff(I2c_DevShtc3, -1, senBuf, 2);
+    if (err != ESP_OK) {
+        ESP_LOGE("shtc3", "StartMeasurement WRITE Failure");
+        Shtc3_Sleep();
+        return ACK_ERROR;
+    }
 
-    // if no error, read temperature and humidity raw values
-    err   = i2cbus_.i2c_read_buff(I2c_DevShtc3, -1, bytes, 6);
-    error = (err == ESP_OK) ? NO_ERROR : ACK_ERROR;
-    if (error != NO_ERROR) {
+    int64_t now      = esp_timer_get_time();
+    meas_ready_us    = now + Shtc3_MeasTimeUs();
+    meas_deadline_us = meas_ready_us + SHTC3_MEAS_TIMEOUT_US;
+    measuring        = true;
+    return NO_ERROR;
+}
+
+etError Shtc3Port::Shtc3_Poll(float *temp, float *humi) {
+    if (!measuring) {
+        return ACK_ERROR;
+    }
+
+    // Reading before the conversion ends is NACKed; don't touch the bus yet
+    int64_t now = esp_timer_get_time();
+    if (now < meas_ready_us) {
+        return NOT_READY;
+    }
+
+    uint8_t bytes[6] = {0};
+    int err          = i2cbus_.i2c_read_buff(I2c_DevShtc3, -1, bytes, 6);
+    if (err != ESP_OK) {
+        if (now < meas_deadline_us) {
+            return NOT_READY;
+        }
         ESP_LOGE("shtc3", "GetTempAndHumi READ Failure");
-        return error;
+        measuring = false;
+        Shtc3_Sleep();
+        return ACK_ERROR;
     }
-    error = Shtc3_CheckCrc(bytes, 2, bytes[2]);
+
+    measuring = false;
+    Shtc3_Sleep();
+
+    etError error = Shtc3_CheckCrc(bytes, 2, bytes[2]);
     if (error != NO_ERROR) {
         ESP_LOGE("shtc3", "GetTempAndHumi TempCRC Failure");
         return error;
@@ -139,11 +171,11 @@ etError Shtc3Port::Shtc3_GetTempAndHumiPolling(float *temp, float *humi) {
         return error;
     }
     // if no error, calculate temperature in °C and humidity in %RH
-    rawValueTemp = (bytes[0] << 8) | bytes[1];
-    rawValueHumi = (bytes[3] << 8) | bytes[4];
-    *temp        = Shtc3_CalcTemperature(rawValueTemp);
-    *humi        = Shtc3_CalcHumidity(rawValueHumi);
-    return error;
+    uint16_t rawValueTemp = (bytes[0] << 8) | bytes[1];
+    uint16_t rawValueHumi = (bytes[3] << 8) | bytes[4];
+    *temp                 = Shtc3_CalcTemperature(rawValueTemp);
+    *humi                 = Shtc3_CalcHumidity(rawValueHumi);
+    return NO_ERROR;
 }
 
 etError Shtc3Port::Shtc3_Sleep() {
@@ -156,16 +188,18 @@ etError Shtc3Port::Shtc3_Sleep() {
 }
 
 uint8_t Shtc3Port::Shtc3_ReadTempHumi(float *t,float *h) {
-    etError      error;
-    Shtc3_Wakeup();
-    error = Shtc3_GetTempAndHumiPolling(t, h);
+    etError error = Shtc3_StartMeasurement();
+    if (error == NO_ERROR) {
+        vTaskDelay(pdMS_TO_TICKS(Shtc3_MeasTimeUs() / 1000 + 1));
+        while ((error = Shtc3_Poll(t, h)) == NOT_READY) {
+            vTaskDelay(1);
+        }
+    }
     if (error != NO_ERROR) {
         ESP_LOGW("shtc3", "error:%d", error);
-    } else {
-        return 0;
+        return 1;
     }
-    Shtc3_Sleep();
-    return 1;
+    return 0;
 }
 
 static i2c_master_dev_handle_t I2cRTCdev = NULL;
@@ -198,12 +232,7 @@ void Rtc_Setup(I2cMasterBus *i2cbus,uint8_t dev_addr) {
         I2cbus_ = i2cbus;
     }
     if (I2cRTCdev == NULL) {
-        i2c_master_bus_handle_t BusHandle = i2cbus->Get_I2cBusHandle();
-        i2c_device_config_t     dev_cfg   = {};
-        dev_cfg.dev_addr_length           = I2C_ADDR_BIT_LEN_7;
-        dev_cfg.scl_speed_hz              = 300000;
-        dev_cfg.device_address            = dev_addr;
-        ESP_ERROR_CHECK(i2c_master_bus_add_device(BusHandle, &dev_cfg, &I2cRTCdev));
+        I2cRTCdev     = i2cbus->i2c_add_device(dev_addr, 300000);
         I2cRTCAddress = dev_addr;
     }
     if (rtc.begin(I2cDevCallback)) {
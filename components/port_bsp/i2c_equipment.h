@@ -2,12 +2,15 @@
 #define I2C_EQUIPMENT_H
 
 
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
 #include "i2c_bsp.h"
 
 typedef enum{
   	NO_ERROR       = 0x00, // no error
   	ACK_ERROR      = 0x01, // no acknowledgment error
-  	CHECKSUM_ERROR = 0x02 // checksum mismatch error
+  	CHECKSUM_ERROR = 0x02, // checksum mismatch error
+  	NOT_READY      = 0x03  // measurement still in progress
 }etError;
 
 typedef enum{
@@ -18,9 +21,19 @@ typedef enum{
   	MEAS_T_RH_POLLING  = 0x7866, // meas. read T first, clock stretching disabled
   	MEAS_T_RH_CLOCKSTR = 0x7CA2, // meas. read T first, clock stretching enabled
   	MEAS_RH_T_POLLING  = 0x58E0, // meas. read RH first, clock stretching disabled
-  	MEAS_RH_T_CLOCKSTR = 0x5C24  // meas. read RH first, clock stretching enabled
+  	MEAS_RH_T_CLOCKSTR = 0x5C24, // meas. read RH first, clock stretching enabled
+  	MEAS_T_RH_POLLING_LP = 0x609C // low power meas. read T first, clock stretching disabled
 }etCommands;
 
+// Datasheet maximums, rounded up
+#define SHTC3_WAKEUP_US        240
+#define SHTC3_MEAS_US          12100
+#define SHTC3_MEAS_LP_US       800
+#define SHTC3_MEAS_TIMEOUT_US  10000 // extra time before a NACKing read gives up
+
+// Subtracted from every temperature reading. Compensated self-heating when the
+// sensor was left awake between reads; now it sleeps after every sample.
+#define SHTC3_DEFAULT_TEMP_OFFSET 4.0f
 
 class Shtc3Port
 {
@@ -28,14 +41,19 @@ private:
 	const char *TAG = "SHTC3";
 	uint16_t shtc3_id = 0x00;
 	const uint16_t CRC_POLYNOMIAL = 0x131;
-	const uint8_t  SHTC3_PETP_VOL = 4;
+	float temp_offset = SHTC3_DEFAULT_TEMP_OFFSET;
+	bool low_power = false;
 	const uint8_t Shtc3Address = 0x70;
 	I2cMasterBus& i2cbus_;
     i2c_master_dev_handle_t I2c_DevShtc3;
 
+	// Measurement in flight (StartMeasurement .. Poll)
+	bool measuring = false;
+	int64_t meas_ready_us = 0;
+	int64_t meas_deadline_us = 0;
+
 	etError Shtc3_GetId();
 	etError Shtc3_CheckCrc(uint8_t data[], uint8_t nbrOfBytes,uint8_t checksum);
-	etError Shtc3_GetTempAndHumiPolling(float *temp, float *humi);
 	float Shtc3_CalcTemperature(uint16_t rawValue);
 	float Shtc3_CalcHumidity(uint16_t rawValue);
 
@@ -47,6 +65,21 @@ public:
 	etError Shtc3_Sleep();
 	etError Shtc3_SoftReset();
 	uint16_t Shtc3_GetShtc3Id();
+
+	// Low power mode: ~0.8 ms conversions with slightly more noise
+	void Shtc3_SetLowPower(bool enable);
+	void Shtc3_SetTempOffset(float offset);
+
+	// Asynchronous API: wake and trigger a conversion, then Poll until it
+	// returns something other than NOT_READY. The sensor is put back to
+	// sleep once the result (or an error) is returned. Not thread safe:
+	// the caller's task owns the measurement, and the bus calls block.
+	etError Shtc3_StartMeasurement();
+	etError Shtc3_Poll(float *temp, float *humi);
+	bool Shtc3_IsMeasuring() { return measuring; }
+	uint32_t Shtc3_MeasTimeUs(); // Conversion time for the current mode
+
+	// Blocking read built on the asynchronous API
 	uint8_t Shtc3_ReadTempHumi(float *t,float *h);
 };
 
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <esp_log.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include "pm_bsp.h"
+
+static const char *TAG = "Pm";
+
+static esp_pm_lock_handle_t pm_locks[PM_LOCK_COUNT];
+
+static const struct {
+    esp_pm_lock_type_t type;
+    const char        *name;
+} pm_lock_defs[PM_LOCK_COUNT] = {
+    [PM_LOCK_RENDER] = {ESP_PM_CPU_FREQ_MAX,   "render"},
+    [PM_LOCK_NET]    = {ESP_PM_CPU_FREQ_MAX,   "net"},
+    [PM_LOCK_I2C]    = {ESP_PM_NO_LIGHT_SLEEP, "i2c"},
+};
+
+#ifdef CONFIG_PM_PROFILING
+static void report_timer_cb(void *arg) {
+    Pm_Report();
+}
+#endif
+
+void Pm_PortInit(void) {
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {};
+    pm_config.max_freq_mhz       = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    pm_config.min_freq_mhz       = PM_MIN_CPU_FREQ_MHZ;
+    pm_config.light_sleep_enable = true;
+
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        // Needs CONFIG_FREERTOS_USE_TICKLESS_IDLE; keep frequency scaling
+        pm_config.light_sleep_enable = false;
+        err = esp_pm_configure(&pm_config);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_pm_configure failed: %s", esp_err_to_name(err));
+        return;
+    }
+
+    for (int i = 0; i < PM_LOCK_COUNT; i++) {
+        ESP_ERROR_CHECK_WITHOUT_ABORT(esp_pm_lock_create(pm_lock_defs[i].type, 0, pm_lock_defs[i].name, &pm_locks[i]));
+    }
+    ESP_LOGI(TAG, "DFS %d-%d MHz, light sleep %s", PM_MIN_CPU_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+             pm_config.light_sleep_enable ? "on" : "off");
+
+#ifdef CONFIG_PM_PROFILING
+    esp_timer_create_args_t report_args = {};
+    report_args.callback                = report_timer_cb;
+    report_args.name                    = "pm_report";
+    report_args.skip_unhandled_events   = true;
+    esp_timer_handle_t report_timer     = NULL;
+    if (esp_timer_create(&report_args, &report_timer) == ESP_OK) {
+        esp_timer_start_periodic(report_timer, (uint64_t)PM_REPORT_PERIOD_S * 1000000);
+    }
+#endif
+#else
+    ESP_LOGW(TAG, "CONFIG_PM_ENABLE is off; running at full clock");
+#endif
+}
+
+void Pm_Acquire(pm_lock_id_t id) {
+    if (id < PM_LOCK_COUNT && pm_locks[id]) {
+        esp_pm_lock_acquire(pm_locks[id]);
+    }
+}
+
+void Pm_Release(pm_lock_id_t id) {
+    if (id < PM_LOCK_COUNT && pm_locks[id]) {
+        esp_pm_lock_release(pm_locks[id]);
+    }
+}
+
+// With CONFIG_PM_PROFILING the dump includes time spent per mode:
+// CPU_MAX/APB_MAX (active), APB_MIN (idle at low clock) and SLEEP
+void Pm_Report(void) {
+#ifdef CONFIG_PM_ENABLE
+    ESP_LOGI(TAG, "Power management residency:");
+    esp_pm_dump_locks(stdout);
+#endif
+}
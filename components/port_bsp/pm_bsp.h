@@ -0,0 +1,27 @@
+#ifndef PM_BSP_H
+#define PM_BSP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PM_MIN_CPU_FREQ_MHZ 40   // XTAL; the floor for DFS
+#define PM_REPORT_PERIOD_S  600  // Residency report interval (CONFIG_PM_PROFILING)
+
+typedef enum {
+    PM_LOCK_RENDER = 0, // LVGL rendering and the SPI flush it triggers: CPU max
+    PM_LOCK_NET,        // HTTPS transfers (TLS handshake): CPU max
+    PM_LOCK_I2C,        // Sensor bursts: no light sleep mid-transaction
+    PM_LOCK_COUNT
+} pm_lock_id_t;
+
+void Pm_PortInit(void);
+void Pm_Acquire(pm_lock_id_t id);
+void Pm_Release(pm_lock_id_t id);
+void Pm_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Static dashboard chrome in DispBuffer's packed landscape layout, generated
+// at build time by tools/splash/gen_splash.py
+extern const uint32_t rlcd_splash_frame_len;
+extern const uint8_t  rlcd_splash_frame[];
+
+#ifdef __cplusplus
+}
+#endif
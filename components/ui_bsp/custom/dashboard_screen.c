@@ -1,7 +1,10 @@
 #include "dashboard_screen.h"
 #include "logo_fetcher.h"
 #include "seven_seg.h"
+#include "sparkline.h"
+#include "status_icons.h"
 #include <stdio.h>
+#include <string.h>
 
 // Declare external fonts from gui_guider.h
 LV_FONT_DECLARE(lv_font_MISANSMEDIUM_20)
@@ -10,15 +13,21 @@ LV_FONT_DECLARE(lv_font_MISANSMEDIUM_18)
 
 // Dashboard objects
 static lv_obj_t *dashboard_cont = NULL;
+static lv_obj_t *static_layer = NULL;
 static lv_obj_t *time_display = NULL;
 static lv_obj_t *temp_label = NULL;
 static lv_obj_t *humidity_label = NULL;
-static lv_obj_t *battery_bar = NULL;
+static lv_obj_t *temp_spark = NULL;
+static lv_obj_t *humidity_spark = NULL;
+static lv_obj_t *battery_icon = NULL;
 static lv_obj_t *battery_pct_label = NULL;
 static lv_obj_t *wifi_icon = NULL;
 static lv_obj_t *score_label = NULL;
 static lv_obj_t *score_label_2 = NULL;
 static lv_obj_t *date_label = NULL;
+static lv_obj_t *tz_label = NULL;
+static lv_obj_t *stale_label = NULL;
+static lv_obj_t *title_label = NULL;
 
 // Logo image objects for two games (away/home for each)
 static lv_obj_t *logo_img_g1_away = NULL;
@@ -32,6 +41,15 @@ static lv_img_dsc_t logo_dsc_g1_home;
 static lv_img_dsc_t logo_dsc_g2_away;
 static lv_img_dsc_t logo_dsc_g2_home;
 
+// Games currently on screen, so updates only touch what changed
+static game_info_t shown_games[2];
+static int shown_count = -1;
+
+// "Just scored" highlight: score label inverted for a few seconds
+#define HIGHLIGHT_MS 10000
+static uint32_t highlight_id = 0;
+static lv_timer_t *highlight_timer = NULL;
+
 // Screen dimensions
 #define SCREEN_W 400
 #define SCREEN_H 300
@@ -40,80 +58,14 @@ static lv_img_dsc_t logo_dsc_g2_home;
 #define TITLE_BAR_H 22
 #define BORDER_W 3
 
-// Battery icon dimensions
-#define BATT_W 24
-#define BATT_H 10
-#define BATT_TIP_W 2
-#define BATT_TIP_H 4
-
-// WiFi bar dimensions
-#define WIFI_W 20
-#define WIFI_H 14
-
-// Create battery icon for title bar (smaller, white on black)
-static lv_obj_t *create_battery_icon(lv_obj_t *parent) {
-  lv_obj_t *batt_cont = lv_obj_create(parent);
-  lv_obj_remove_style_all(batt_cont);
-  lv_obj_set_size(batt_cont, BATT_W + BATT_TIP_W + 2, BATT_H + 2);
-  lv_obj_clear_flag(batt_cont, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Battery outline (white)
-  lv_obj_t *outline = lv_obj_create(batt_cont);
-  lv_obj_remove_style_all(outline);
-  lv_obj_set_size(outline, BATT_W, BATT_H);
-  lv_obj_set_pos(outline, 0, 1);
-  lv_obj_set_style_border_width(outline, 1, 0);
-  lv_obj_set_style_border_color(outline, lv_color_white(), 0);
-  lv_obj_set_style_radius(outline, 1, 0);
-  lv_obj_set_style_bg_opa(outline, LV_OPA_TRANSP, 0);
-  lv_obj_clear_flag(outline, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Battery tip (white)
-  lv_obj_t *tip = lv_obj_create(batt_cont);
-  lv_obj_remove_style_all(tip);
-  lv_obj_set_size(tip, BATT_TIP_W, BATT_TIP_H);
-  lv_obj_set_pos(tip, BATT_W, (BATT_H - BATT_TIP_H) / 2 + 1);
-  lv_obj_set_style_bg_color(tip, lv_color_white(), 0);
-  lv_obj_set_style_bg_opa(tip, LV_OPA_COVER, 0);
-  lv_obj_clear_flag(tip, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Battery fill bar (white, inside)
-  battery_bar = lv_obj_create(outline);
-  lv_obj_remove_style_all(battery_bar);
-  lv_obj_set_size(battery_bar, BATT_W - 4, BATT_H - 4);
-  lv_obj_set_pos(battery_bar, 1, 1);
-  lv_obj_set_style_bg_color(battery_bar, lv_color_white(), 0);
-  lv_obj_set_style_bg_opa(battery_bar, LV_OPA_COVER, 0);
-  lv_obj_clear_flag(battery_bar, LV_OBJ_FLAG_SCROLLABLE);
-
-  return batt_cont;
-}
-
-// Create WiFi signal bars (white for title bar)
-static lv_obj_t *create_wifi_icon(lv_obj_t *parent) {
-  lv_obj_t *wifi_cont = lv_obj_create(parent);
-  lv_obj_remove_style_all(wifi_cont);
-  lv_obj_set_size(wifi_cont, WIFI_W, WIFI_H);
-  lv_obj_clear_flag(wifi_cont, LV_OBJ_FLAG_SCROLLABLE);
-
-  int bar_w = 3;
-  int gap = 2;
-  int heights[] = {3, 6, 9, 12};
-
-  for (int i = 0; i < 4; i++) {
-    lv_obj_t *bar = lv_obj_create(wifi_cont);
-    lv_obj_remove_style_all(bar);
-    lv_obj_set_size(bar, bar_w, heights[i]);
-    lv_obj_set_pos(bar, i * (bar_w + gap), WIFI_H - heights[i]);
-    lv_obj_set_style_bg_color(bar, lv_color_white(), 0);
-    lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, 0);
-    lv_obj_clear_flag(bar, LV_OBJ_FLAG_SCROLLABLE);
-  }
-
-  wifi_icon = wifi_cont;
-  return wifi_cont;
-}
+// Climate sparklines (left column, beside the readings)
+#define SPARK_X 110
+#define SPARK_W 85
+#define SPARK_H 24
 
+// The static parts (borders, title bar, dividers, captions) are mirrored by
+// tools/splash/gen_splash.py for the boot splash; keep the two in sync.
+// The title bar stays out of static_layer: its children are white on it.
 void dashboard_create(lv_obj_t *parent) {
   // ========== MAIN WINDOW CONTAINER ==========
   dashboard_cont = lv_obj_create(parent);
@@ -126,9 +78,19 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_pad_all(dashboard_cont, 0, 0);
   lv_obj_clear_flag(dashboard_cont, LV_OBJ_FLAG_SCROLLABLE);
 
+  // ========== STATIC LAYER ==========
+  // Everything in here is fixed after boot; the compositor bakes it into a
+  // background plane once and hides it. Nothing dynamic may overlap it.
+  static_layer = lv_obj_create(dashboard_cont);
+  lv_obj_remove_style_all(static_layer);
+  lv_obj_set_pos(static_layer, 0, 0);
+  lv_obj_set_size(static_layer, SCREEN_W, SCREEN_H);
+  lv_obj_clear_flag(static_layer,
+                    LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
   // ========== WIN3.1 OUTER BORDER (raised 3D effect) ==========
   // Outer white line (top-left highlight)
-  lv_obj_t *border_outer = lv_obj_create(dashboard_cont);
+  lv_obj_t *border_outer = lv_obj_create(static_layer);
   lv_obj_remove_style_all(border_outer);
   lv_obj_set_pos(border_outer, 0, 0);
   lv_obj_set_size(border_outer, SCREEN_W, SCREEN_H);
@@ -138,7 +100,7 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_clear_flag(border_outer, LV_OBJ_FLAG_SCROLLABLE);
 
   // Inner frame border
-  lv_obj_t *border_inner = lv_obj_create(dashboard_cont);
+  lv_obj_t *border_inner = lv_obj_create(static_layer);
   lv_obj_remove_style_all(border_inner);
   lv_obj_set_pos(border_inner, 3, 3);
   lv_obj_set_size(border_inner, SCREEN_W - 6, SCREEN_H - 6);
@@ -157,15 +119,15 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_clear_flag(title_bar, LV_OBJ_FLAG_SCROLLABLE);
 
   // Title text - centered, white on black
-  lv_obj_t *title_label = lv_label_create(title_bar);
+  title_label = lv_label_create(title_bar);
   lv_label_set_text(title_label, "RLCD");
   lv_obj_set_style_text_font(title_label, &lv_font_montserrat_14, 0);
   lv_obj_set_style_text_color(title_label, lv_color_white(), 0);
   lv_obj_center(title_label);
 
   // Battery icon in title bar (right side)
-  lv_obj_t *batt_icon = create_battery_icon(title_bar);
-  lv_obj_set_pos(batt_icon, SCREEN_W - 80, 4);
+  battery_icon = battery_icon_create(title_bar);
+  lv_obj_set_pos(battery_icon, SCREEN_W - 80, 4);
 
   // Battery percentage label (in title bar)
   battery_pct_label = lv_label_create(title_bar);
@@ -175,19 +137,28 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_text_font(battery_pct_label, &lv_font_montserrat_14, 0);
   lv_obj_set_style_text_color(battery_pct_label, lv_color_white(), 0);
 
+  // Stale-scores indicator in title bar (left side), shown while the scores
+  // come from the persisted snapshot
+  stale_label = lv_label_create(title_bar);
+  lv_label_set_text(stale_label, "CACHED");
+  lv_obj_align(stale_label, LV_ALIGN_LEFT_MID, 8, 0);
+  lv_obj_set_style_text_font(stale_label, &lv_font_montserrat_14, 0);
+  lv_obj_set_style_text_color(stale_label, lv_color_white(), 0);
+  lv_obj_add_flag(stale_label, LV_OBJ_FLAG_HIDDEN);
+
   // WiFi icon in title bar (far right)
-  lv_obj_t *wifi = create_wifi_icon(title_bar);
-  lv_obj_align(wifi, LV_ALIGN_RIGHT_MID, -8, 0);
+  wifi_icon = wifi_icon_create(title_bar);
+  lv_obj_align(wifi_icon, LV_ALIGN_RIGHT_MID, -8, 0);
 
   // ========== CONTENT AREA ==========
   int content_y = 4 + TITLE_BAR_H + 4; // Below title bar
 
   // ========== TIME DISPLAY (TOP LEFT) ==========
-  time_display = seven_seg_create(dashboard_cont);
+  time_display = seven_seg_create(dashboard_cont, &SEVEN_SEG_MEDIUM);
   lv_obj_set_pos(time_display, 15, content_y + 10);
 
   // Date label just to the right of CST
-  lv_obj_t *time_label = lv_label_create(dashboard_cont);
+  tz_label = lv_label_create(dashboard_cont);
   date_label = lv_label_create(dashboard_cont);
   lv_label_set_text(date_label, "Jan 01, 2026");
   lv_obj_set_pos(date_label, 65, content_y + 95); // Moved up to avoid divider
@@ -195,14 +166,14 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_text_color(date_label, lv_color_black(), 0);
 
   // Adjust CST label position
-  lv_label_set_text(time_label, "CST");
-  lv_obj_set_pos(time_label, 15, content_y + 95); // Moved up to avoid divider
-  lv_obj_set_style_text_font(time_label, &lv_font_MISANSMEDIUM_18, 0);
-  lv_obj_set_style_text_color(time_label, lv_color_black(), 0);
+  lv_label_set_text(tz_label, "CST");
+  lv_obj_set_pos(tz_label, 15, content_y + 95); // Moved up to avoid divider
+  lv_obj_set_style_text_font(tz_label, &lv_font_MISANSMEDIUM_18, 0);
+  lv_obj_set_style_text_color(tz_label, lv_color_black(), 0);
 
   // ========== CLIMATE DISPLAY (LEFT SIDE, BELOW TIME) ==========
   // Temperature section header
-  lv_obj_t *temp_text = lv_label_create(dashboard_cont);
+  lv_obj_t *temp_text = lv_label_create(static_layer);
   lv_label_set_text(temp_text, "TEMP");
   lv_obj_set_pos(temp_text, 15, content_y + 125); // Moved up
   lv_obj_set_style_text_font(temp_text, &lv_font_MISANSMEDIUM_18, 0);
@@ -216,7 +187,7 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_text_color(temp_label, lv_color_black(), 0);
 
   // Humidity section header
-  lv_obj_t *humid_text = lv_label_create(dashboard_cont);
+  lv_obj_t *humid_text = lv_label_create(static_layer);
   lv_label_set_text(humid_text, "HUMIDITY");
   lv_obj_set_pos(humid_text, 15, content_y + 185); // Moved up
   lv_obj_set_style_text_font(humid_text, &lv_font_MISANSMEDIUM_18, 0);
@@ -229,9 +200,15 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_text_font(humidity_label, &lv_font_MISANSMEDIUM_25, 0);
   lv_obj_set_style_text_color(humidity_label, lv_color_black(), 0);
 
+  // History sparklines, right of the readings
+  temp_spark = sparkline_create(dashboard_cont, SPARK_W, SPARK_H);
+  lv_obj_set_pos(temp_spark, SPARK_X, content_y + 148);
+  humidity_spark = sparkline_create(dashboard_cont, SPARK_W, SPARK_H);
+  lv_obj_set_pos(humidity_spark, SPARK_X, content_y + 208);
+
   // ========== WIN3.1 STYLE SEPARATOR LINES ==========
   // Horizontal line below time area
-  lv_obj_t *h_line = lv_obj_create(dashboard_cont);
+  lv_obj_t *h_line = lv_obj_create(static_layer);
   lv_obj_remove_style_all(h_line);
   lv_obj_set_pos(h_line, 10, content_y + 118); // Moved up
   lv_obj_set_size(h_line, 190, 2);
@@ -240,7 +217,7 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_clear_flag(h_line, LV_OBJ_FLAG_SCROLLABLE);
 
   // Vertical divider moved to center
-  lv_obj_t *v_line = lv_obj_create(dashboard_cont);
+  lv_obj_t *v_line = lv_obj_create(static_layer);
   lv_obj_remove_style_all(v_line);
   lv_obj_set_pos(v_line, 205, content_y + 5);
   lv_obj_set_size(v_line, 2, SCREEN_H - content_y - 15);
@@ -282,7 +259,7 @@ void dashboard_create(lv_obj_t *parent) {
   lv_obj_set_style_text_align(score_label, LV_TEXT_ALIGN_LEFT, 0);
 
   // Horizontal divider between games
-  lv_obj_t *game_divider = lv_obj_create(dashboard_cont);
+  lv_obj_t *game_divider = lv_obj_create(static_layer);
   lv_obj_remove_style_all(game_divider);
   lv_obj_set_pos(game_divider, right_x, content_y + 106);
   lv_obj_set_size(game_divider, SCREEN_W - right_x - 10, 1);
@@ -322,6 +299,42 @@ void dashboard_update_date(const char *date_str) {
   }
 }
 
+// "CST*" while the clock runs from the RTC without a recent NTP sync
+void dashboard_set_clock_synced(bool synced) {
+  if (tz_label) {
+    lv_label_set_text(tz_label, synced ? "CST" : "CST*");
+  }
+}
+
+// Last frame before deep sleep: title shows when the dashboard comes back
+void dashboard_show_night(int wake_hour, int wake_minute) {
+  if (title_label) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "QUIET UNTIL %02d:%02d", wake_hour, wake_minute);
+    lv_label_set_text(title_label, buf);
+  }
+  if (stale_label) {
+    lv_obj_add_flag(stale_label, LV_OBJ_FLAG_HIDDEN);
+  }
+}
+
+lv_obj_t *dashboard_get_static_layer(void) { return static_layer; }
+
+void dashboard_get_clock_area(lv_area_t *area) {
+  if (time_display) {
+    lv_obj_update_layout(time_display);
+    lv_obj_get_coords(time_display, area);
+  } else {
+    lv_area_set(area, 0, 0, -1, -1);
+  }
+}
+
+const seven_seg_size_t *dashboard_get_clock_size(void) {
+  const seven_seg_size_t *size =
+      time_display ? seven_seg_get_size(time_display) : NULL;
+  return size ? size : &SEVEN_SEG_MEDIUM;
+}
+
 void dashboard_update_time(int hours, int minutes, bool colon_visible) {
   if (time_display) {
     seven_seg_set_time(time_display, hours, minutes, colon_visible);
@@ -330,8 +343,8 @@ void dashboard_update_time(int hours, int minutes, bool colon_visible) {
 
 // Helper function to load logo and set on image widget
 static void load_and_set_logo(lv_obj_t *img_obj, lv_img_dsc_t *img_dsc,
-                              const char *url) {
-  if (!img_obj || !img_dsc || !url || strlen(url) == 0) {
+                              team_handle_t team) {
+  if (!img_obj || !img_dsc || team == TEAM_HANDLE_NONE) {
     if (img_obj)
       lv_obj_add_flag(img_obj, LV_OBJ_FLAG_HIDDEN);
     return;
@@ -344,7 +357,7 @@ static void load_and_set_logo(lv_obj_t *img_obj, lv_img_dsc_t *img_dsc,
   }
 
   logo_data_t logo;
-  if (logo_fetcher_get(url, &logo)) {
+  if (logo_fetcher_get(team, &logo)) {
     // Setup LVGL image descriptor
     img_dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
     img_dsc->header.w = logo.width;
@@ -360,46 +373,142 @@ static void load_and_set_logo(lv_obj_t *img_obj, lv_img_dsc_t *img_dsc,
   }
 }
 
+static void set_label_highlight(lv_obj_t *label, bool on) {
+  lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+  lv_obj_set_style_bg_opa(label, on ? LV_OPA_COVER : LV_OPA_TRANSP, 0);
+  lv_obj_set_style_text_color(label, on ? lv_color_white() : lv_color_black(),
+                              0);
+}
+
+// Update one game slot, touching only the widgets whose data changed
+static void update_game_slot(int slot, const game_info_t *game) {
+  lv_obj_t *label = (slot == 0) ? score_label : score_label_2;
+  lv_obj_t *img_away = (slot == 0) ? logo_img_g1_away : logo_img_g2_away;
+  lv_obj_t *img_home = (slot == 0) ? logo_img_g1_home : logo_img_g2_home;
+  lv_img_dsc_t *dsc_away = (slot == 0) ? &logo_dsc_g1_away : &logo_dsc_g2_away;
+  lv_img_dsc_t *dsc_home = (slot == 0) ? &logo_dsc_g1_home : &logo_dsc_g2_home;
+  game_info_t *shown = &shown_games[slot];
+  bool had_game = slot < shown_count;
+
+  if (!label)
+    return;
+
+  if (!game) {
+    if (had_game || shown_count < 0) {
+      lv_label_set_text(label, slot == 0 ? "No games" : "");
+      if (img_away)
+        lv_obj_add_flag(img_away, LV_OBJ_FLAG_HIDDEN);
+      if (img_home)
+        lv_obj_add_flag(img_home, LV_OBJ_FLAG_HIDDEN);
+    }
+    return;
+  }
+
+  // Format: Team1 Score\\n  vs\\nTeam2 Score\\nStatus
+  // Added leading spaces to "vs" to center it
+  if (!had_game || shown->away_score != game->away_score ||
+      shown->home_score != game->home_score ||
+      strcmp(shown->status, game->status) != 0 ||
+      shown->away_team != game->away_team ||
+      shown->home_team != game->home_team) {
+    lv_label_set_text_fmt(label, "%s %d\n   vs\n%s %d\n%s",
+                          team_registry_abbrev(game->away_team),
+                          game->away_score,
+                          team_registry_abbrev(game->home_team),
+                          game->home_score, game->status);
+  }
+
+  bool highlight = highlight_timer && game->id == highlight_id;
+  if (!had_game || shown->id != game->id || highlight) {
+    set_label_highlight(label, highlight);
+  }
+
+  // Logos only change when a different matchup rotates in
+  if (!had_game || shown->away_team != game->away_team) {
+    load_and_set_logo(img_away, dsc_away, game->away_team);
+  }
+  if (!had_game || shown->home_team != game->home_team) {
+    load_and_set_logo(img_home, dsc_home, game->home_team);
+  }
+}
+
+void dashboard_refresh_logos(void) {
+  for (int slot = 0; slot < shown_count; slot++) {
+    lv_obj_t *img_away = (slot == 0) ? logo_img_g1_away : logo_img_g2_away;
+    lv_obj_t *img_home = (slot == 0) ? logo_img_g1_home : logo_img_g2_home;
+    lv_img_dsc_t *dsc_away =
+        (slot == 0) ? &logo_dsc_g1_away : &logo_dsc_g2_away;
+    lv_img_dsc_t *dsc_home =
+        (slot == 0) ? &logo_dsc_g1_home : &logo_dsc_g2_home;
+
+    // Only retry images still waiting on a download
+    if (!dsc_away->data) {
+      load_and_set_logo(img_away, dsc_away, shown_games[slot].away_team);
+    }
+    if (!dsc_home->data) {
+      load_and_set_logo(img_home, dsc_home, shown_games[slot].home_team);
+    }
+  }
+}
+
 void dashboard_update_scores(game_info_t *games, int count) {
-  if (score_label && count > 0) {
-    // Format: Team1 Score\\n  vs\\nTeam2 Score\\nStatus
-    // Added leading spaces to "vs" to center it
-    lv_label_set_text_fmt(score_label, "%s %d\n   vs\n%s %d\n%s",
-                          games[0].away_abbrev, games[0].away_score,
-                          games[0].home_abbrev, games[0].home_score,
-                          games[0].status);
-
-    // Load and set logos for game 1
-    load_and_set_logo(logo_img_g1_away, &logo_dsc_g1_away,
-                      games[0].away_logo_url);
-    load_and_set_logo(logo_img_g1_home, &logo_dsc_g1_home,
-                      games[0].home_logo_url);
-  } else if (score_label) {
-    lv_label_set_text(score_label, "No games");
-    if (logo_img_g1_away)
-      lv_obj_add_flag(logo_img_g1_away, LV_OBJ_FLAG_HIDDEN);
-    if (logo_img_g1_home)
-      lv_obj_add_flag(logo_img_g1_home, LV_OBJ_FLAG_HIDDEN);
+  if (count < 0)
+    count = 0;
+  if (count > 2)
+    count = 2;
+
+  for (int slot = 0; slot < 2; slot++) {
+    update_game_slot(slot, slot < count ? &games[slot] : NULL);
+    if (slot < count)
+      shown_games[slot] = games[slot];
+  }
+  shown_count = count;
+}
+
+static void highlight_timer_cb(lv_timer_t *timer) {
+  highlight_timer = NULL;
+  highlight_id = 0;
+  for (int slot = 0; slot < shown_count; slot++) {
+    set_label_highlight(slot == 0 ? score_label : score_label_2, false);
+  }
+}
+
+void dashboard_highlight_game(uint32_t game_id) {
+  if (highlight_timer) {
+    lv_timer_reset(highlight_timer);
+  } else {
+    highlight_timer = lv_timer_create(highlight_timer_cb, HIGHLIGHT_MS, NULL);
+    lv_timer_set_repeat_count(highlight_timer, 1);
+  }
+  highlight_id = game_id;
+
+  for (int slot = 0; slot < shown_count; slot++) {
+    lv_obj_t *label = (slot == 0) ? score_label : score_label_2;
+    set_label_highlight(label, shown_games[slot].id == game_id);
   }
+}
 
-  if (score_label_2 && count > 1) {
-    lv_label_set_text_fmt(score_label_2, "%s %d\n   vs\n%s %d\n%s",
-                          games[1].away_abbrev, games[1].away_score,
-                          games[1].home_abbrev, games[1].home_score,
-                          games[1].status);
-
-    // Load and set logos for game 2
-    load_and_set_logo(logo_img_g2_away, &logo_dsc_g2_away,
-                      games[1].away_logo_url);
-    load_and_set_logo(logo_img_g2_home, &logo_dsc_g2_home,
-                      games[1].home_logo_url);
-  } else if (score_label_2) {
-    lv_label_set_text(score_label_2, "");
-    if (logo_img_g2_away)
-      lv_obj_add_flag(logo_img_g2_away, LV_OBJ_FLAG_HIDDEN);
-    if (logo_img_g2_home)
-      lv_obj_add_flag(logo_img_g2_home, LV_OBJ_FLAG_HIDDEN);
+void dashboard_set_scores_stale(bool stale, int age_min) {
+  if (!stale_label)
+    return;
+  if (!stale) {
+    lv_obj_add_flag(stale_label, LV_OBJ_FLAG_HIDDEN);
+    return;
   }
+
+  // "CACHED 40m", "CACHED 5h", "CACHED 2d"; no age while the clock is unset
+  char buf[20];
+  if (age_min < 0)
+    snprintf(buf, sizeof(buf), "CACHED");
+  else if (age_min < 60)
+    snprintf(buf, sizeof(buf), "CACHED %dm", age_min);
+  else if (age_min < 48 * 60)
+    snprintf(buf, sizeof(buf), "CACHED %dh", age_min / 60);
+  else
+    snprintf(buf, sizeof(buf), "CACHED %dd", age_min / (24 * 60));
+  if (strcmp(lv_label_get_text(stale_label), buf) != 0)
+    lv_label_set_text(stale_label, buf);
+  lv_obj_clear_flag(stale_label, LV_OBJ_FLAG_HIDDEN);
 }
 
 void dashboard_update_climate(float temp_f, float humidity) {
@@ -417,6 +526,17 @@ void dashboard_update_climate(float temp_f, float humidity) {
   }
 }
 
+void dashboard_update_climate_history(const int16_t *temp, int temp_count,
+                                      const int16_t *humidity,
+                                      int humidity_count) {
+  if (temp_spark) {
+    sparkline_set_data(temp_spark, temp, temp_count);
+  }
+  if (humidity_spark) {
+    sparkline_set_data(humidity_spark, humidity, humidity_count);
+  }
+}
+
 void dashboard_update_battery(uint8_t percent) {
   char buf[8];
 
@@ -429,44 +549,29 @@ void dashboard_update_battery(uint8_t percent) {
     lv_label_set_text(battery_pct_label, buf);
   }
 
-  // Update fill bar width (max width is BATT_W - 4 = 20)
-  if (battery_bar) {
-    int fill_w = (BATT_W - 4) * percent / 100;
-    if (fill_w < 2)
-      fill_w = 2;
-    lv_obj_set_width(battery_bar, fill_w);
-  }
+  // Redraws only when the fill bar gains or loses a pixel
+  battery_icon_set_percent(battery_icon, percent);
 }
 
-void dashboard_update_wifi(int8_t rssi, bool connected) {
-  if (!wifi_icon)
-    return;
+int dashboard_wifi_bars(int8_t rssi, bool connected) {
+  if (!connected)
+    return 0;
+  if (rssi > -50)
+    return 4;
+  if (rssi > -60)
+    return 3;
+  if (rssi > -70)
+    return 2;
+  return 1;
+}
 
-  // Get number of bars to show based on RSSI
-  int bars = 0;
-  if (connected) {
-    if (rssi > -50)
-      bars = 4;
-    else if (rssi > -60)
-      bars = 3;
-    else if (rssi > -70)
-      bars = 2;
-    else
-      bars = 1;
-  }
+void dashboard_set_wifi_bars(int bars) {
+  // Redraws only when the bar count changes
+  wifi_icon_set_bars(wifi_icon, bars);
+}
 
-  // Update bar visibility (white = active, dim = inactive)
-  int child_count = lv_obj_get_child_cnt(wifi_icon);
-  for (int i = 0; i < child_count && i < 4; i++) {
-    lv_obj_t *bar = lv_obj_get_child(wifi_icon, i);
-    if (i < bars) {
-      lv_obj_set_style_bg_color(bar, lv_color_white(), 0);
-      lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, 0);
-    } else {
-      // Dim for inactive bars
-      lv_obj_set_style_bg_opa(bar, LV_OPA_40, 0);
-    }
-  }
+void dashboard_update_wifi(int8_t rssi, bool connected) {
+  dashboard_set_wifi_bars(dashboard_wifi_bars(rssi, connected));
 }
 
 lv_obj_t *dashboard_get_container(void) { return dashboard_cont; }
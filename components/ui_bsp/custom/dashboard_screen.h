@@ -2,31 +2,73 @@
 #define DASHBOARD_SCREEN_H
 
 #include "lvgl.h"
+#include "seven_seg.h"
+#include "team_registry.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct {
-  char away_abbrev[8];
-  char home_abbrev[8];
-  int away_score;
-  int home_score;
-  char status[32]; // "FINAL", "2nd 5:30", "1/31 - 7:00 PM"
-  char away_logo_url[128];
-  char home_logo_url[128];
+  uint32_t id; // ESPN event ID, stable across refreshes
+  team_handle_t away_team;
+  team_handle_t home_team;
+  int16_t away_score;
+  int16_t home_score;
   bool is_live;
+  char status[32]; // "FINAL", "2nd 5:30", "1/31 - 7:00 PM"
 } game_info_t;
 
 void dashboard_create(lv_obj_t *parent);
 void dashboard_update_time(int hours, int minutes, bool colon_visible);
 void dashboard_update_scores(game_info_t *games, int count);
+void dashboard_refresh_logos(void);
+void dashboard_highlight_game(uint32_t game_id);
+
+/**
+ * @brief Show or hide the "CACHED" tag on the scores
+ * @param age_min Snapshot age in minutes, or -1 if unknown
+ */
+void dashboard_set_scores_stale(bool stale, int age_min);
 void dashboard_update_date(const char *date_str);
+void dashboard_set_clock_synced(bool synced);
 void dashboard_update_climate(float temp_f, float humidity);
+void dashboard_update_climate_history(const int16_t *temp, int temp_count,
+                                      const int16_t *humidity,
+                                      int humidity_count);
 void dashboard_update_battery(uint8_t percent);
 void dashboard_update_wifi(int8_t rssi, bool connected);
+void dashboard_set_wifi_bars(int bars);
+
+/**
+ * @brief Signal bars (0-4) shown for a WiFi state
+ */
+int dashboard_wifi_bars(int8_t rssi, bool connected);
 lv_obj_t *dashboard_get_container(void);
 
+/**
+ * @brief Switch the title bar to the night-mode message ("QUIET UNTIL hh:mm")
+ */
+void dashboard_show_night(int wake_hour, int wake_minute);
+
+/**
+ * @brief Container of the never-changing objects (borders, captions,
+ * dividers), for the compositor to bake and hide
+ * @return NULL before dashboard_create()
+ */
+lv_obj_t *dashboard_get_static_layer(void);
+
+/**
+ * @brief Screen coordinates of the 7-segment clock
+ * @param area Filled with the clock's bounding box (empty before creation)
+ */
+void dashboard_get_clock_area(lv_area_t *area);
+
+/**
+ * @brief Digit geometry of the 7-segment clock, for seven_seg_paint()
+ */
+const seven_seg_size_t *dashboard_get_clock_size(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 #include "seven_seg.h"
+#include "esp_heap_caps.h"
 #include <stdio.h>
+#include <string.h>
 
 // Segment definitions for digits 0-9
 // Segments are: top, top-right, bottom-right, bottom, bottom-left, top-left,
@@ -18,28 +20,73 @@ static const uint8_t SEGMENT_MAP[10] = {
     0b1111011, // 9: a,b,c,d,f,g
 };
 
-// Medium digit dimensions to fit better
-#define SEG_DIGIT_W 32
-#define SEG_DIGIT_H 60
-#define SEG_THICK 6
-#define SEG_GAP 2       // Increased gap to prevent segments from merging
-#define DIGIT_SPACING 8 // More even spacing
-#define COLON_W 12      // Wider colon for better spacing
-
-// 4 digits + 1 colon + 4 spacing gaps + some padding
-#define CANVAS_WIDTH (4 * SEG_DIGIT_W + 1 * COLON_W + 4 * DIGIT_SPACING + 10)
-#define CANVAS_HEIGHT (SEG_DIGIT_H + 8)
+//                                         w   h   thick gap spacing colon dot
+const seven_seg_size_t SEVEN_SEG_SMALL = {22, 40, 4, 1, 6, 8, 6};
+const seven_seg_size_t SEVEN_SEG_MEDIUM = {32, 60, 6, 2, 8, 12, 8};
+const seven_seg_size_t SEVEN_SEG_LARGE = {36, 80, 8, 2, 4, 12, 10};
+
+// Palette index 1 is ink; the palette precedes the pixel data in the buffer
+#define SEG_PALETTE_BYTES (2 * sizeof(lv_color32_t))
+
+// Glyph cache: every digit, the colon and a blank cell, rendered once as
+// packed 1-bit rows (MSB first, 1 = lit, same as the canvas)
+#define GLYPH_COLON 10
+#define GLYPH_BLANK 11
+#define GLYPH_COUNT 12
+
+// Cells on the canvas: HH : MM. Each starts on a byte boundary so a glyph
+// row goes onto the canvas with one memcpy.
+#define CELL_COUNT 5
+#define CELL_COLON 2
+
+typedef struct {
+  int cell_x[CELL_COUNT];
+  int w; // Canvas size
+  int h;
+} seg_layout_t;
+
+typedef struct {
+  seven_seg_size_t size;
+  seg_layout_t layout;
+  lv_obj_t *canvas;
+  uint8_t *buf;    // Canvas: palette, then rows of stride bytes
+  uint8_t *glyphs; // GLYPH_COUNT x digit_h rows of glyph_stride bytes (PSRAM)
+  int stride;
+  int glyph_stride;
+  int8_t shown[CELL_COUNT]; // Glyph in each cell, as on the canvas
+} seven_seg_t;
+
+// Glyph being rendered by glyph_px()
+typedef struct {
+  uint8_t *rows;
+  int stride;
+  int w;
+  int h;
+} glyph_target_t;
+
+static int round8(int v) { return (v + 7) & ~7; }
+
+static int cell_width(const seven_seg_size_t *sz, int cell) {
+  return cell == CELL_COLON ? sz->colon_w : sz->digit_w;
+}
 
-static lv_obj_t *time_canvas = NULL;
-static lv_color_t *canvas_buf = NULL;
+static void seg_layout(const seven_seg_size_t *sz, seg_layout_t *l) {
+  int x = 0;
+  for (int i = 0; i < CELL_COUNT; i++) {
+    l->cell_x[i] = x;
+    x += round8(cell_width(sz, i) + sz->spacing);
+  }
+  l->w = round8(l->cell_x[CELL_COUNT - 1] + sz->digit_w);
+  l->h = sz->digit_h + 8;
+}
 
 // Draw a horizontal segment with pointed ends (like real 7-segment)
 // Shape: pointed on left and right ends
-static void draw_h_segment(lv_obj_t *canvas, int x, int y, int len,
-                           lv_color_t color) {
-  int half_thick = SEG_THICK / 2;
+static void draw_h_segment(const seven_seg_size_t *sz, seven_seg_px_cb_t px,
+                           void *ctx, int x, int y, int len) {
+  int half_thick = sz->thick / 2;
 
-  for (int row = 0; row < SEG_THICK; row++) {
+  for (int row = 0; row < sz->thick; row++) {
     // Calculate how far from center this row is
     int dist_from_center =
         (row < half_thick) ? (half_thick - row) : (row - half_thick + 1);
@@ -49,18 +96,18 @@ static void draw_h_segment(lv_obj_t *canvas, int x, int y, int len,
     int end_x = x + len - dist_from_center;
 
     for (int col = start_x; col <= end_x; col++) {
-      lv_canvas_set_px_color(canvas, col, y + row, color);
+      px(col, y + row, ctx);
     }
   }
 }
 
 // Draw a vertical segment with pointed ends (like real 7-segment)
 // Shape: pointed on top and bottom ends
-static void draw_v_segment(lv_obj_t *canvas, int x, int y, int len,
-                           lv_color_t color) {
-  int half_thick = SEG_THICK / 2;
+static void draw_v_segment(const seven_seg_size_t *sz, seven_seg_px_cb_t px,
+                           void *ctx, int x, int y, int len) {
+  int half_thick = sz->thick / 2;
 
-  for (int col = 0; col < SEG_THICK; col++) {
+  for (int col = 0; col < sz->thick; col++) {
     // Calculate how far from center this column is
     int dist_from_center =
         (col < half_thick) ? (half_thick - col) : (col - half_thick + 1);
@@ -70,154 +117,264 @@ static void draw_v_segment(lv_obj_t *canvas, int x, int y, int len,
     int end_y = y + len - dist_from_center;
 
     for (int row = start_y; row <= end_y; row++) {
-      lv_canvas_set_px_color(canvas, x + col, row, color);
+      px(x + col, row, ctx);
     }
   }
 }
 
 // Draw a single 7-segment digit with pointed segment ends
-static void draw_digit(lv_obj_t *canvas, int digit, int x_offset,
-                       lv_color_t color) {
+static void draw_digit(const seven_seg_size_t *sz, seven_seg_px_cb_t px,
+                       void *ctx, int digit, int x_offset) {
   if (digit < 0 || digit > 9)
     return;
 
   uint8_t segments = SEGMENT_MAP[digit];
 
-  int h_seg_len = SEG_DIGIT_W - 2 * SEG_GAP;
-  int v_seg_len = (SEG_DIGIT_H - SEG_THICK) / 2 - SEG_GAP;
-  int mid_y = SEG_DIGIT_H / 2;
+  int h_seg_len = sz->digit_w - 2 * sz->gap;
+  int v_seg_len = (sz->digit_h - sz->thick) / 2 - sz->gap;
+  int mid_y = sz->digit_h / 2;
 
   // Segment a (top horizontal)
   if (segments & 0b1000000) {
-    draw_h_segment(canvas, x_offset + SEG_GAP, 0, h_seg_len, color);
+    draw_h_segment(sz, px, ctx, x_offset + sz->gap, 0, h_seg_len);
   }
 
   // Segment b (top-right vertical)
   if (segments & 0b0100000) {
-    draw_v_segment(canvas, x_offset + SEG_DIGIT_W - SEG_THICK,
-                   SEG_THICK / 2 + SEG_GAP, v_seg_len, color);
+    draw_v_segment(sz, px, ctx, x_offset + sz->digit_w - sz->thick,
+                   sz->thick / 2 + sz->gap, v_seg_len);
   }
 
   // Segment c (bottom-right vertical)
   if (segments & 0b0010000) {
-    draw_v_segment(canvas, x_offset + SEG_DIGIT_W - SEG_THICK, mid_y + SEG_GAP,
-                   v_seg_len, color);
+    draw_v_segment(sz, px, ctx, x_offset + sz->digit_w - sz->thick,
+                   mid_y + sz->gap, v_seg_len);
   }
 
   // Segment d (bottom horizontal)
   if (segments & 0b0001000) {
-    draw_h_segment(canvas, x_offset + SEG_GAP, SEG_DIGIT_H - SEG_THICK,
-                   h_seg_len, color);
+    draw_h_segment(sz, px, ctx, x_offset + sz->gap, sz->digit_h - sz->thick,
+                   h_seg_len);
   }
 
   // Segment e (bottom-left vertical)
   if (segments & 0b0000100) {
-    draw_v_segment(canvas, x_offset, mid_y + SEG_GAP, v_seg_len, color);
+    draw_v_segment(sz, px, ctx, x_offset, mid_y + sz->gap, v_seg_len);
   }
 
   // Segment f (top-left vertical)
   if (segments & 0b0000010) {
-    draw_v_segment(canvas, x_offset, SEG_THICK / 2 + SEG_GAP, v_seg_len, color);
+    draw_v_segment(sz, px, ctx, x_offset, sz->thick / 2 + sz->gap, v_seg_len);
   }
 
   // Segment g (middle horizontal)
   if (segments & 0b0000001) {
-    draw_h_segment(canvas, x_offset + SEG_GAP, mid_y - SEG_THICK / 2, h_seg_len,
-                   color);
+    draw_h_segment(sz, px, ctx, x_offset + sz->gap, mid_y - sz->thick / 2,
+                   h_seg_len);
   }
 }
 
-static void draw_colon(lv_obj_t *canvas, int x_offset, lv_color_t color) {
-  int dot_size = 8; // Larger dots for better visibility and proportion
-  int cx = x_offset + COLON_W / 2 - dot_size / 2;
+static void draw_colon(const seven_seg_size_t *sz, seven_seg_px_cb_t px,
+                       void *ctx, int x_offset) {
+  int dot_size = sz->dot;
+  int cx = x_offset + sz->colon_w / 2 - dot_size / 2;
 
   // Top dot
-  int top_y = SEG_DIGIT_H / 3 - dot_size / 2;
+  int top_y = sz->digit_h / 3 - dot_size / 2;
   for (int dy = 0; dy < dot_size; dy++) {
     for (int dx = 0; dx < dot_size; dx++) {
-      lv_canvas_set_px_color(canvas, cx + dx, top_y + dy, color);
+      px(cx + dx, top_y + dy, ctx);
     }
   }
 
   // Bottom dot
-  int bot_y = 2 * SEG_DIGIT_H / 3 - dot_size / 2;
+  int bot_y = 2 * sz->digit_h / 3 - dot_size / 2;
   for (int dy = 0; dy < dot_size; dy++) {
     for (int dx = 0; dx < dot_size; dx++) {
-      lv_canvas_set_px_color(canvas, cx + dx, bot_y + dy, color);
+      px(cx + dx, bot_y + dy, ctx);
     }
   }
 }
 
-lv_obj_t *seven_seg_create(lv_obj_t *parent) {
+static void cell_glyphs(int hours, int minutes, bool colon_visible,
+                        int8_t out[CELL_COUNT]) {
+  out[0] = hours / 10;
+  out[1] = hours % 10;
+  out[CELL_COLON] = colon_visible ? GLYPH_COLON : GLYPH_BLANK;
+  out[3] = minutes / 10;
+  out[4] = minutes % 10;
+  for (int i = 0; i < CELL_COUNT; i++) {
+    if (out[i] < 0 || out[i] > GLYPH_BLANK)
+      out[i] = GLYPH_BLANK;
+  }
+}
+
+static void glyph_px(int x, int y, void *ctx) {
+  glyph_target_t *g = (glyph_target_t *)ctx;
+  if (x >= 0 && x < g->w && y >= 0 && y < g->h) {
+    g->rows[y * g->stride + (x >> 3)] |= 0x80 >> (x & 7);
+  }
+}
+
+static uint8_t *glyph_rows(seven_seg_t *s, int glyph) {
+  return s->glyphs + glyph * s->size.digit_h * s->glyph_stride;
+}
+
+static void glyphs_init(seven_seg_t *s) {
+  memset(s->glyphs, 0, GLYPH_COUNT * s->size.digit_h * s->glyph_stride);
+  glyph_target_t g = {NULL, s->glyph_stride, s->size.digit_w, s->size.digit_h};
+  for (int d = 0; d < 10; d++) {
+    g.rows = glyph_rows(s, d);
+    draw_digit(&s->size, glyph_px, &g, d, 0);
+  }
+  g.rows = glyph_rows(s, GLYPH_COLON);
+  g.w = s->size.colon_w;
+  draw_colon(&s->size, glyph_px, &g, 0);
+}
+
+// Copy a cached glyph into its canvas cell and invalidate just that cell
+static void blit_cell(seven_seg_t *s, int cell, int glyph) {
+  int x0 = s->layout.cell_x[cell];
+  int w = cell_width(&s->size, cell);
+  int bytes = round8(w) >> 3;
+  const uint8_t *src = glyph_rows(s, glyph);
+  uint8_t *dst = s->buf + SEG_PALETTE_BYTES + (x0 >> 3);
+
+  for (int y = 0; y < s->size.digit_h; y++) {
+    memcpy(dst, src, bytes);
+    src += s->glyph_stride;
+    dst += s->stride;
+  }
+  s->shown[cell] = glyph;
+
+  lv_area_t area;
+  lv_obj_get_coords(s->canvas, &area);
+  area.x1 += x0;
+  area.x2 = area.x1 + w - 1;
+  area.y2 = area.y1 + s->size.digit_h - 1;
+  lv_obj_invalidate_area(s->canvas, &area);
+}
+
+// Allocate and lay out the canvas and glyph cache for s->size
+static bool seven_seg_alloc(seven_seg_t *s) {
+  seg_layout(&s->size, &s->layout);
+  s->stride = s->layout.w >> 3;
+  s->glyph_stride = round8(LV_MAX(s->size.digit_w, s->size.colon_w)) >> 3;
+
+  uint32_t buf_size =
+      LV_CANVAS_BUF_SIZE_INDEXED_1BIT(s->layout.w, s->layout.h);
+  s->buf = (uint8_t *)lv_mem_alloc(buf_size);
+  s->glyphs = (uint8_t *)heap_caps_malloc(
+      GLYPH_COUNT * s->size.digit_h * s->glyph_stride, MALLOC_CAP_SPIRAM);
+  if (!s->buf || !s->glyphs) {
+    heap_caps_free(s->glyphs);
+    lv_mem_free(s->buf);
+    s->buf = NULL;
+    s->glyphs = NULL;
+    return false;
+  }
+
+  lv_canvas_set_buffer(s->canvas, s->buf, s->layout.w, s->layout.h,
+                       LV_IMG_CF_INDEXED_1BIT);
+  lv_canvas_set_palette(s->canvas, 0, lv_color_white());
+  lv_canvas_set_palette(s->canvas, 1, lv_color_black());
+  memset(s->buf + SEG_PALETTE_BYTES, 0, buf_size - SEG_PALETTE_BYTES);
+  for (int i = 0; i < CELL_COUNT; i++) {
+    s->shown[i] = GLYPH_BLANK;
+  }
+  glyphs_init(s);
+
+  lv_obj_set_size(lv_obj_get_parent(s->canvas), s->layout.w, s->layout.h);
+  lv_obj_invalidate(s->canvas);
+  return true;
+}
+
+static void seven_seg_delete_cb(lv_event_t *e) {
+  seven_seg_t *s = (seven_seg_t *)lv_event_get_user_data(e);
+  heap_caps_free(s->glyphs);
+  lv_mem_free(s->buf);
+  lv_mem_free(s);
+}
+
+lv_obj_t *seven_seg_create(lv_obj_t *parent, const seven_seg_size_t *size) {
   // Create container
   lv_obj_t *container = lv_obj_create(parent);
   lv_obj_remove_style_all(container);
-  lv_obj_set_size(container, CANVAS_WIDTH, CANVAS_HEIGHT);
   lv_obj_set_style_bg_opa(container, LV_OPA_TRANSP, 0);
 
-  // Allocate canvas buffer
-  canvas_buf = (lv_color_t *)lv_mem_alloc(CANVAS_WIDTH * CANVAS_HEIGHT *
-                                          sizeof(lv_color_t));
-  if (!canvas_buf) {
+  seven_seg_t *s = (seven_seg_t *)lv_mem_alloc(sizeof(seven_seg_t));
+  if (!s) {
     return container;
   }
+  memset(s, 0, sizeof(*s));
+  s->size = size ? *size : SEVEN_SEG_MEDIUM;
 
   // Create canvas for drawing
-  time_canvas = lv_canvas_create(container);
-  lv_canvas_set_buffer(time_canvas, canvas_buf, CANVAS_WIDTH, CANVAS_HEIGHT,
-                       LV_IMG_CF_TRUE_COLOR);
-  lv_obj_align(time_canvas, LV_ALIGN_TOP_LEFT, 0, 0);
-
-  // Fill with white background
-  lv_canvas_fill_bg(time_canvas, lv_color_white(), LV_OPA_COVER);
+  s->canvas = lv_canvas_create(container);
+  lv_obj_align(s->canvas, LV_ALIGN_TOP_LEFT, 0, 0);
+  if (!seven_seg_alloc(s)) {
+    lv_obj_del(s->canvas);
+    lv_mem_free(s);
+    return container;
+  }
 
+  lv_obj_set_user_data(container, s);
+  lv_obj_add_event_cb(container, seven_seg_delete_cb, LV_EVENT_DELETE, s);
   return container;
 }
 
-void seven_seg_set_time(lv_obj_t *container, int hours, int minutes,
-                        bool colon_visible) {
-  if (!time_canvas)
-    return;
-
-  static int last_h = -1;
-  static int last_m = -1;
-  static int last_c = -1;
+bool seven_seg_set_size(lv_obj_t *container, const seven_seg_size_t *size) {
+  seven_seg_t *s = (seven_seg_t *)lv_obj_get_user_data(container);
+  if (!s || !size)
+    return false;
 
-  // Only redraw if anything changed
-  if (hours == last_h && minutes == last_m && (int)colon_visible == last_c) {
-    return;
+  seven_seg_t old = *s;
+  s->size = *size;
+  if (!seven_seg_alloc(s)) {
+    *s = old;
+    return false;
   }
+  heap_caps_free(old.glyphs);
+  lv_mem_free(old.buf);
+  return true;
+}
 
-  last_h = hours;
-  last_m = minutes;
-  last_c = (int)colon_visible;
-
-  // Clear canvas with white
-  lv_canvas_fill_bg(time_canvas, lv_color_white(), LV_OPA_COVER);
-
-  lv_color_t seg_color = lv_color_black();
-  int x = 0;
-
-  // Hours tens
-  draw_digit(time_canvas, hours / 10, x, seg_color);
-  x += SEG_DIGIT_W + DIGIT_SPACING;
+const seven_seg_size_t *seven_seg_get_size(lv_obj_t *container) {
+  seven_seg_t *s = (seven_seg_t *)lv_obj_get_user_data(container);
+  return s ? &s->size : NULL;
+}
 
-  // Hours ones
-  draw_digit(time_canvas, hours % 10, x, seg_color);
-  x += SEG_DIGIT_W + DIGIT_SPACING;
+void seven_seg_set_time(lv_obj_t *container, int hours, int minutes,
+                        bool colon_visible) {
+  seven_seg_t *s = (seven_seg_t *)lv_obj_get_user_data(container);
+  if (!s)
+    return;
 
-  // Colon (blinking - only draw when visible)
-  if (colon_visible) {
-    draw_colon(time_canvas, x, seg_color);
+  // Only cells whose glyph changed are copied and invalidated; a colon
+  // blink touches the colon cell alone
+  int8_t want[CELL_COUNT];
+  cell_glyphs(hours, minutes, colon_visible, want);
+  for (int i = 0; i < CELL_COUNT; i++) {
+    if (want[i] != s->shown[i]) {
+      blit_cell(s, i, want[i]);
+    }
   }
-  x += COLON_W + DIGIT_SPACING;
-
-  // Minutes tens
-  draw_digit(time_canvas, minutes / 10, x, seg_color);
-  x += SEG_DIGIT_W + DIGIT_SPACING;
-
-  // Minutes ones
-  draw_digit(time_canvas, minutes % 10, x, seg_color);
+}
 
-  lv_obj_invalidate(time_canvas);
+void seven_seg_paint(const seven_seg_size_t *size, int hours, int minutes,
+                     bool colon_visible, seven_seg_px_cb_t px, void *ctx) {
+  if (!size)
+    size = &SEVEN_SEG_MEDIUM;
+  seg_layout_t layout;
+  seg_layout(size, &layout);
+
+  int8_t cells[CELL_COUNT];
+  cell_glyphs(hours, minutes, colon_visible, cells);
+  for (int i = 0; i < CELL_COUNT; i++) {
+    if (cells[i] == GLYPH_COLON) {
+      draw_colon(size, px, ctx, layout.cell_x[i]);
+    } else if (cells[i] != GLYPH_BLANK) {
+      draw_digit(size, px, ctx, cells[i], layout.cell_x[i]);
+    }
+  }
 }
@@ -7,12 +7,45 @@
 extern "C" {
 #endif
 
+// Plots one segment pixel at (x, y), relative to the display's top-left
+typedef void (*seven_seg_px_cb_t)(int x, int y, void *ctx);
+
+// Digit geometry, in pixels
+typedef struct {
+  uint8_t digit_w; // Digit cell width
+  uint8_t digit_h; // Digit cell height
+  uint8_t thick;   // Segment thickness
+  uint8_t gap;     // Gap between segment ends
+  uint8_t spacing; // Space between cells (cells start on 8 px boundaries)
+  uint8_t colon_w; // Colon cell width
+  uint8_t dot;     // Colon dot size
+} seven_seg_size_t;
+
+extern const seven_seg_size_t SEVEN_SEG_SMALL;  // 22x40 digits
+extern const seven_seg_size_t SEVEN_SEG_MEDIUM; // 32x60, the dashboard clock
+extern const seven_seg_size_t SEVEN_SEG_LARGE;  // 36x80, as wide as MEDIUM
+
 /**
  * @brief Create a 7-segment time display widget
+ * @note The canvas is 1 bit per pixel and the glyph cache lives outside the
+ * LVGL heap, so larger sizes cost little of CONFIG_LV_MEM_SIZE_KILOBYTES
  * @param parent Parent object to add the display to
+ * @param size Digit geometry, copied; NULL for SEVEN_SEG_MEDIUM
  * @return Container object for the time display
  */
-lv_obj_t *seven_seg_create(lv_obj_t *parent);
+lv_obj_t *seven_seg_create(lv_obj_t *parent, const seven_seg_size_t *size);
+
+/**
+ * @brief Switch an existing display to another digit size
+ * @note Resizes the container and redraws on the next seven_seg_set_time()
+ * @return false if the new buffers could not be allocated (size unchanged)
+ */
+bool seven_seg_set_size(lv_obj_t *container, const seven_seg_size_t *size);
+
+/**
+ * @brief Digit geometry of a display, NULL if container is not one
+ */
+const seven_seg_size_t *seven_seg_get_size(lv_obj_t *container);
 
 /**
  * @brief Update the time shown on the 7-segment display (HH:MM format)
@@ -25,6 +58,21 @@ lv_obj_t *seven_seg_create(lv_obj_t *parent);
 void seven_seg_set_time(lv_obj_t *container, int hours, int minutes,
                         bool colon_visible);
 
+/**
+ * @brief Draw HH:MM through a pixel callback, without LVGL
+ * @note Used to repaint the clock straight into the panel framebuffer when
+ * waking from night-mode deep sleep. Only lit pixels are plotted; the caller
+ * clears the area first. The layout matches a widget of the same size.
+ * @param size Digit geometry; NULL for SEVEN_SEG_MEDIUM
+ * @param hours Hours (0-23)
+ * @param minutes Minutes (0-59)
+ * @param colon_visible Whether to draw the colon
+ * @param px Pixel callback
+ * @param ctx Passed to px
+ */
+void seven_seg_paint(const seven_seg_size_t *size, int hours, int minutes,
+                     bool colon_visible, seven_seg_px_cb_t px, void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,175 @@
+#include "sparkline.h"
+#include <string.h>
+
+// Palette index 1 is ink; the palette precedes the pixel data in the buffer
+#define SPARK_PALETTE_BYTES (2 * sizeof(lv_color32_t))
+
+typedef struct {
+  uint8_t *buf;
+  lv_coord_t w;
+  lv_coord_t h;
+  uint16_t *picked; // LTTB output, w entries
+} sparkline_t;
+
+static void set_px(sparkline_t *s, int x, int y) {
+  if (x < 0 || y < 0 || x >= s->w || y >= s->h)
+    return;
+  int stride = (s->w + 7) / 8;
+  s->buf[SPARK_PALETTE_BYTES + y * stride + x / 8] |= 0x80 >> (x % 8);
+}
+
+static void draw_line(sparkline_t *s, int x0, int y0, int x1, int y1) {
+  int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+
+  for (;;) {
+    set_px(s, x0, y0);
+    if (x0 == x1 && y0 == y1)
+      break;
+    int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+// Largest-Triangle-Three-Buckets: keep the first and last sample and, from
+// each of the (out - 2) buckets in between, the sample forming the largest
+// triangle with the previous pick and the next bucket's average. O(count).
+static int lttb(const int16_t *values, int count, uint16_t *picked, int out) {
+  if (out >= count || out < 3) {
+    int n = count < out ? count : out;
+    for (int i = 0; i < n; i++)
+      picked[i] = (uint16_t)(i * (count - 1) / (n > 1 ? n - 1 : 1));
+    return n;
+  }
+
+  int n = 0;
+  int a = 0;
+  picked[n++] = 0;
+
+  int32_t every = ((count - 2) << 8) / (out - 2); // Bucket size, 24.8 fixed
+  for (int i = 0; i < out - 2; i++) {
+    int start = ((i * every) >> 8) + 1;
+    int end = (((i + 1) * every) >> 8) + 1;
+    int next_start = end;
+    int next_end = (((i + 2) * every) >> 8) + 1;
+    if (next_end > count)
+      next_end = count;
+
+    int32_t avg_x = 0, avg_y = 0;
+    int next_n = next_end - next_start;
+    if (next_n <= 0) {
+      avg_x = count - 1;
+      avg_y = values[count - 1];
+    } else {
+      for (int j = next_start; j < next_end; j++) {
+        avg_x += j;
+        avg_y += values[j];
+      }
+      avg_x /= next_n;
+      avg_y /= next_n;
+    }
+
+    int best = start;
+    int64_t best_area = -1;
+    for (int j = start; j < end; j++) {
+      int64_t area = (int64_t)(a - avg_x) * (values[j] - values[a]) -
+                     (int64_t)(a - j) * (avg_y - values[a]);
+      if (area < 0)
+        area = -area;
+      if (area > best_area) {
+        best_area = area;
+        best = j;
+      }
+    }
+    picked[n++] = (uint16_t)best;
+    a = best;
+  }
+
+  picked[n++] = (uint16_t)(count - 1);
+  return n;
+}
+
+static void sparkline_delete_cb(lv_event_t *e) {
+  sparkline_t *s = (sparkline_t *)lv_event_get_user_data(e);
+  lv_mem_free(s->picked);
+  lv_mem_free(s->buf);
+  lv_mem_free(s);
+}
+
+lv_obj_t *sparkline_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h) {
+  lv_obj_t *canvas = lv_canvas_create(parent);
+
+  sparkline_t *s = (sparkline_t *)lv_mem_alloc(sizeof(sparkline_t));
+  if (!s)
+    return canvas;
+  s->w = w;
+  s->h = h;
+  s->buf = (uint8_t *)lv_mem_alloc(LV_CANVAS_BUF_SIZE_INDEXED_1BIT(w, h));
+  s->picked = (uint16_t *)lv_mem_alloc(w * sizeof(uint16_t));
+  if (!s->buf || !s->picked) {
+    lv_mem_free(s->picked);
+    lv_mem_free(s->buf);
+    lv_mem_free(s);
+    return canvas;
+  }
+
+  lv_canvas_set_buffer(canvas, s->buf, w, h, LV_IMG_CF_INDEXED_1BIT);
+  lv_canvas_set_palette(canvas, 0, lv_color_white());
+  lv_canvas_set_palette(canvas, 1, lv_color_black());
+  memset(s->buf + SPARK_PALETTE_BYTES, 0,
+         LV_CANVAS_BUF_SIZE_INDEXED_1BIT(w, h) - SPARK_PALETTE_BYTES);
+
+  lv_obj_set_user_data(canvas, s);
+  lv_obj_add_event_cb(canvas, sparkline_delete_cb, LV_EVENT_DELETE, s);
+  return canvas;
+}
+
+void sparkline_set_data(lv_obj_t *spark, const int16_t *values, int count) {
+  sparkline_t *s = (sparkline_t *)lv_obj_get_user_data(spark);
+  if (!s)
+    return;
+
+  memset(s->buf + SPARK_PALETTE_BYTES, 0,
+         LV_CANVAS_BUF_SIZE_INDEXED_1BIT(s->w, s->h) - SPARK_PALETTE_BYTES);
+
+  if (count >= 2) {
+    int n = lttb(values, count, s->picked, s->w);
+
+    int16_t vmin = values[s->picked[0]];
+    int16_t vmax = vmin;
+    for (int i = 1; i < n; i++) {
+      int16_t v = values[s->picked[i]];
+      if (v < vmin)
+        vmin = v;
+      if (v > vmax)
+        vmax = v;
+    }
+    int32_t range = vmax - vmin;
+
+    int prev_x = 0, prev_y = 0;
+    for (int i = 0; i < n; i++) {
+      int idx = s->picked[i];
+      int x = idx * (s->w - 1) / (count - 1);
+      // Flat series sit in the middle; otherwise top = max
+      int y = range ? (s->h - 1) -
+                          (int)((values[idx] - vmin) * (s->h - 1) / range)
+                    : s->h / 2;
+      if (i > 0)
+        draw_line(s, prev_x, prev_y, x, y);
+      prev_x = x;
+      prev_y = y;
+    }
+  }
+
+  lv_obj_invalidate(spark);
+}
@@ -0,0 +1,34 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create a sparkline drawn into a 1-bit canvas
+ * @param parent Parent object
+ * @param w Width in pixels; also the maximum number of plotted points
+ * @param h Height in pixels
+ * @return The canvas object
+ */
+lv_obj_t *sparkline_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h);
+
+/**
+ * @brief Plot a series, auto-scaled to its own min/max
+ * @note Series longer than the width are reduced with LTTB, so the line
+ * keeps its peaks and dips; the drawing itself is O(width)
+ * @param spark Object returned by sparkline_create
+ * @param values Samples, oldest first
+ * @param count Number of samples; fewer than 2 clears the sparkline
+ */
+void sparkline_set_data(lv_obj_t *spark, const int16_t *values, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPARKLINE_H
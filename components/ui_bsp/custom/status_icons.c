@@ -0,0 +1,124 @@
+#include "status_icons.h"
+
+// WiFi bars, left to right
+#define WIFI_BAR_W 3
+#define WIFI_BAR_GAP 2
+static const uint8_t WIFI_BAR_H[WIFI_ICON_BARS] = {3, 6, 9, 12};
+
+// Battery body, tip and fill; the fill sits 1 px inside the outline
+#define BATT_W 24
+#define BATT_H 10
+#define BATT_TIP_W 2
+#define BATT_TIP_H 4
+#define BATT_FILL_MAX (BATT_W - 4)
+#define BATT_FILL_MIN 2
+
+static int icon_state(lv_obj_t *icon) {
+  return (int)(intptr_t)lv_obj_get_user_data(icon);
+}
+
+// Redraw only when the quantized state actually changes
+static void icon_set_state(lv_obj_t *icon, int state) {
+  if (icon_state(icon) == state)
+    return;
+  lv_obj_set_user_data(icon, (void *)(intptr_t)state);
+  lv_obj_invalidate(icon);
+}
+
+static lv_obj_t *icon_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h,
+                             lv_event_cb_t draw_cb, int state) {
+  lv_obj_t *icon = lv_obj_create(parent);
+  lv_obj_remove_style_all(icon);
+  lv_obj_set_size(icon, w, h);
+  lv_obj_clear_flag(icon, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_set_user_data(icon, (void *)(intptr_t)state);
+  lv_obj_add_event_cb(icon, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  return icon;
+}
+
+static void fill_rect(lv_draw_ctx_t *draw_ctx, lv_draw_rect_dsc_t *dsc,
+                      lv_coord_t x1, lv_coord_t y1, lv_coord_t w,
+                      lv_coord_t h) {
+  lv_area_t area = {x1, y1, (lv_coord_t)(x1 + w - 1), (lv_coord_t)(y1 + h - 1)};
+  lv_draw_rect(draw_ctx, dsc, &area);
+}
+
+static void wifi_icon_draw_cb(lv_event_t *e) {
+  lv_obj_t *icon = lv_event_get_target(e);
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  int bars = icon_state(icon);
+
+  lv_area_t coords;
+  lv_obj_get_coords(icon, &coords);
+
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = lv_color_white();
+  for (int i = 0; i < WIFI_ICON_BARS; i++) {
+    // Inactive bars are dimmed rather than left out
+    dsc.bg_opa = i < bars ? LV_OPA_COVER : LV_OPA_40;
+    fill_rect(draw_ctx, &dsc, coords.x1 + i * (WIFI_BAR_W + WIFI_BAR_GAP),
+              coords.y1 + WIFI_ICON_H - WIFI_BAR_H[i], WIFI_BAR_W,
+              WIFI_BAR_H[i]);
+  }
+}
+
+lv_obj_t *wifi_icon_create(lv_obj_t *parent) {
+  return icon_create(parent, WIFI_ICON_W, WIFI_ICON_H, wifi_icon_draw_cb,
+                     WIFI_ICON_BARS);
+}
+
+void wifi_icon_set_bars(lv_obj_t *icon, int bars) {
+  if (!icon)
+    return;
+  if (bars < 0)
+    bars = 0;
+  if (bars > WIFI_ICON_BARS)
+    bars = WIFI_ICON_BARS;
+  icon_set_state(icon, bars);
+}
+
+static void battery_icon_draw_cb(lv_event_t *e) {
+  lv_obj_t *icon = lv_event_get_target(e);
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  int fill_w = icon_state(icon);
+
+  lv_area_t coords;
+  lv_obj_get_coords(icon, &coords);
+  lv_coord_t x = coords.x1;
+  lv_coord_t y = coords.y1 + 1;
+
+  // Outline
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_opa = LV_OPA_TRANSP;
+  dsc.border_width = 1;
+  dsc.border_color = lv_color_white();
+  dsc.border_opa = LV_OPA_COVER;
+  dsc.radius = 1;
+  fill_rect(draw_ctx, &dsc, x, y, BATT_W, BATT_H);
+
+  // Tip and fill
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = lv_color_white();
+  dsc.bg_opa = LV_OPA_COVER;
+  fill_rect(draw_ctx, &dsc, x + BATT_W, y + (BATT_H - BATT_TIP_H) / 2,
+            BATT_TIP_W, BATT_TIP_H);
+  fill_rect(draw_ctx, &dsc, x + 2, y + 2, fill_w, BATT_H - 4);
+}
+
+lv_obj_t *battery_icon_create(lv_obj_t *parent) {
+  return icon_create(parent, BATTERY_ICON_W, BATTERY_ICON_H,
+                     battery_icon_draw_cb, BATT_FILL_MAX);
+}
+
+void battery_icon_set_percent(lv_obj_t *icon, uint8_t percent) {
+  if (!icon)
+    return;
+  if (percent > 100)
+    percent = 100;
+  int fill_w = BATT_FILL_MAX * percent / 100;
+  if (fill_w < BATT_FILL_MIN)
+    fill_w = BATT_FILL_MIN;
+  icon_set_state(icon, fill_w);
+}
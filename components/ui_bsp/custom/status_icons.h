@@ -0,0 +1,49 @@
+#ifndef STATUS_ICONS_H
+#define STATUS_ICONS_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Title bar indicators: one object each, drawn white by their own draw
+// callback, with the quantized state kept in user_data
+
+#define WIFI_ICON_W 20
+#define WIFI_ICON_H 14
+#define WIFI_ICON_BARS 4
+
+#define BATTERY_ICON_W 28 // Body, tip and a pixel of slack
+#define BATTERY_ICON_H 12
+
+/**
+ * @brief Create a WiFi signal indicator (starts with all bars lit)
+ */
+lv_obj_t *wifi_icon_create(lv_obj_t *parent);
+
+/**
+ * @brief Show a signal level
+ * @param bars Lit bars, 0-WIFI_ICON_BARS; the rest are drawn dimmed
+ * @note Invalidates only if the bar count changed
+ */
+void wifi_icon_set_bars(lv_obj_t *icon, int bars);
+
+/**
+ * @brief Create a battery indicator (starts full)
+ */
+lv_obj_t *battery_icon_create(lv_obj_t *parent);
+
+/**
+ * @brief Show a charge level
+ * @param percent 0-100, quantized to the fill bar's pixel width
+ * @note Invalidates only if the fill width changed
+ */
+void battery_icon_set_percent(lv_obj_t *icon, uint8_t percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATUS_ICONS_H
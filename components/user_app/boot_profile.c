@@ -0,0 +1,120 @@
+#include "boot_profile.h"
+#include "esp_timer.h"
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <stdbool.h>
+
+static const char *TAG = "Boot";
+
+typedef struct {
+  const char *name;
+  int64_t start_us; // esp_timer time, which counts from chip reset
+  int64_t end_us;   // 0 while running
+} boot_span_t;
+
+static boot_span_t spans[BOOT_PROFILE_MAX_SPANS];
+static int span_count = 0;
+static portMUX_TYPE span_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool frame_seen = false;
+static uint32_t ttff_ms = 0;
+static bool finished = false;
+static bool summary_done = false;
+
+int boot_profile_begin(const char *name) {
+  int64_t now = esp_timer_get_time();
+  int span = -1;
+  portENTER_CRITICAL(&span_lock);
+  if (span_count < BOOT_PROFILE_MAX_SPANS) {
+    span = span_count++;
+    spans[span].name = name;
+    spans[span].start_us = now;
+    spans[span].end_us = 0;
+  }
+  portEXIT_CRITICAL(&span_lock);
+  return span;
+}
+
+static void print_summary(void) {
+  boot_span_t copy[BOOT_PROFILE_MAX_SPANS];
+  portENTER_CRITICAL(&span_lock);
+  int count = span_count;
+  for (int i = 0; i < count; i++) {
+    copy[i] = spans[i];
+  }
+  portEXIT_CRITICAL(&span_lock);
+
+  // Spans overlap when phases run on different tasks; start/end are
+  // absolute so the overlap is visible
+  ESP_LOGI(TAG, "%-14s %8s %8s %8s", "phase", "start", "end", "ms");
+  for (int i = 0; i < count; i++) {
+    if (copy[i].end_us) {
+      ESP_LOGI(TAG, "%-14s %8.1f %8.1f %8.1f", copy[i].name,
+               copy[i].start_us / 1000.0, copy[i].end_us / 1000.0,
+               (copy[i].end_us - copy[i].start_us) / 1000.0);
+    } else {
+      ESP_LOGI(TAG, "%-14s %8.1f  running", copy[i].name,
+               copy[i].start_us / 1000.0);
+    }
+  }
+
+  if (ttff_ms > BOOT_TTFF_TARGET_MS) {
+    ESP_LOGW(TAG, "First frame at %u ms, over the %u ms target",
+             (unsigned)ttff_ms, (unsigned)BOOT_TTFF_TARGET_MS);
+  } else {
+    ESP_LOGI(TAG, "First frame at %u ms (target %u ms)", (unsigned)ttff_ms,
+             (unsigned)BOOT_TTFF_TARGET_MS);
+  }
+}
+
+// Log the summary from whichever call completes the boot. Called with
+// span_lock held; returns true if the caller should print.
+static bool claim_summary(void) {
+  if (summary_done || !finished || !frame_seen)
+    return false;
+  for (int i = 0; i < span_count; i++) {
+    if (!spans[i].end_us)
+      return false;
+  }
+  summary_done = true;
+  return true;
+}
+
+void boot_profile_end(int span) {
+  int64_t now = esp_timer_get_time();
+  if (span < 0 || span >= BOOT_PROFILE_MAX_SPANS)
+    return;
+  portENTER_CRITICAL(&span_lock);
+  spans[span].end_us = now;
+  bool print = claim_summary();
+  portEXIT_CRITICAL(&span_lock);
+  if (print)
+    print_summary();
+}
+
+void boot_profile_finish(void) {
+  portENTER_CRITICAL(&span_lock);
+  finished = true;
+  bool print = claim_summary();
+  portEXIT_CRITICAL(&span_lock);
+  if (print)
+    print_summary();
+}
+
+void boot_profile_first_frame(void) {
+  if (frame_seen)
+    return;
+
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  portENTER_CRITICAL(&span_lock);
+  bool first = !frame_seen;
+  if (first) {
+    ttff_ms = now_ms;
+    frame_seen = true;
+  }
+  bool print = first && claim_summary();
+  portEXIT_CRITICAL(&span_lock);
+  if (print)
+    print_summary();
+}
+
+uint32_t boot_profile_ttff_ms(void) { return ttff_ms; }
@@ -0,0 +1,49 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Time to first frame, from chip reset to the first image on the panel (the
+// splash, or the first LVGL flush when there is none)
+#define BOOT_TTFF_TARGET_MS 700
+
+#define BOOT_PROFILE_MAX_SPANS 16
+
+/**
+ * @brief Start timing a boot phase (any task)
+ * @param name Static string, shown in the summary
+ * @return Span handle for boot_profile_end(), -1 if the table is full
+ */
+int boot_profile_begin(const char *name);
+
+/**
+ * @brief Finish a boot phase started with boot_profile_begin()
+ */
+void boot_profile_end(int span);
+
+/**
+ * @brief Call whenever a frame reaches the panel; the first call records the
+ * time to first frame, later calls return immediately
+ */
+void boot_profile_first_frame(void);
+
+/**
+ * @brief Mark the end of the last bring-up stage; the summary is logged once
+ * no span is still running and the first frame has been recorded
+ */
+void boot_profile_finish(void);
+
+/**
+ * @brief Time to first frame in milliseconds, 0 until it has happened
+ */
+uint32_t boot_profile_ttff_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_PROFILE_H
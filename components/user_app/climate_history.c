@@ -0,0 +1,119 @@
+#include "climate_history.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+
+static const uint32_t level_seconds[HISTORY_LEVEL_COUNT] = {60, 600, 3600};
+static const int level_buckets[HISTORY_LEVEL_COUNT] = {60, 144, 168};
+
+// Bucket being filled at one level
+typedef struct {
+  uint32_t start_s; // Bucket start, aligned to the level period
+  int32_t sum;      // Sum of sample (or child bucket) means
+  uint16_t count;
+  int16_t min;
+  int16_t max;
+} history_acc_t;
+
+typedef struct {
+  history_bucket_t buckets[HISTORY_MAX_BUCKETS];
+  uint16_t head; // Next slot to write
+  uint16_t count;
+  history_acc_t acc;
+} history_level_state_t;
+
+static history_level_state_t levels[HISTORY_SERIES_COUNT][HISTORY_LEVEL_COUNT];
+static SemaphoreHandle_t history_mutex = NULL;
+static volatile uint32_t history_version = 0;
+
+void climate_history_init(void) {
+  if (!history_mutex) {
+    history_mutex = xSemaphoreCreateMutex();
+  }
+  memset(levels, 0, sizeof(levels));
+}
+
+static void acc_add(history_acc_t *acc, int16_t mean, int16_t min,
+                    int16_t max) {
+  if (acc->count == 0) {
+    acc->min = min;
+    acc->max = max;
+  } else {
+    if (min < acc->min)
+      acc->min = min;
+    if (max > acc->max)
+      acc->max = max;
+  }
+  acc->sum += mean;
+  acc->count++;
+}
+
+// Close the bucket at this level if now_s has moved past it, cascading the
+// result into the next level. At most one close per level per call.
+static void roll_level(history_series_t series, int level, uint32_t now_s) {
+  history_level_state_t *st = &levels[series][level];
+  uint32_t start = now_s - now_s % level_seconds[level];
+
+  if (st->acc.count == 0) {
+    st->acc.start_s = start;
+    return;
+  }
+  if (start == st->acc.start_s) {
+    return;
+  }
+
+  history_bucket_t *b = &st->buckets[st->head];
+  b->min = st->acc.min;
+  b->max = st->acc.max;
+  b->mean = (int16_t)(st->acc.sum / st->acc.count);
+  st->head = (st->head + 1) % level_buckets[level];
+  if (st->count < level_buckets[level])
+    st->count++;
+
+  if (level + 1 < HISTORY_LEVEL_COUNT) {
+    roll_level(series, level + 1, st->acc.start_s);
+    acc_add(&levels[series][level + 1].acc, b->mean, b->min, b->max);
+  }
+
+  memset(&st->acc, 0, sizeof(st->acc));
+  st->acc.start_s = start;
+  history_version++;
+}
+
+void climate_history_add(history_series_t series, float value, uint32_t now_s) {
+  if (series >= HISTORY_SERIES_COUNT || !history_mutex)
+    return;
+
+  float scaled = value * HISTORY_SCALE;
+  if (scaled > INT16_MAX)
+    scaled = INT16_MAX;
+  if (scaled < INT16_MIN)
+    scaled = INT16_MIN;
+  int16_t v = (int16_t)scaled;
+
+  xSemaphoreTake(history_mutex, portMAX_DELAY);
+  roll_level(series, HISTORY_1MIN, now_s);
+  acc_add(&levels[series][HISTORY_1MIN].acc, v, v, v);
+  xSemaphoreGive(history_mutex);
+}
+
+int climate_history_read(history_series_t series, history_level_t level,
+                         history_bucket_t *out, int max) {
+  if (series >= HISTORY_SERIES_COUNT || level >= HISTORY_LEVEL_COUNT ||
+      !history_mutex)
+    return 0;
+
+  xSemaphoreTake(history_mutex, portMAX_DELAY);
+  const history_level_state_t *st = &levels[series][level];
+  int n = st->count < max ? st->count : max;
+  int size = level_buckets[level];
+  // Newest n buckets, oldest first
+  int first = (st->head - n + size) % size;
+  for (int i = 0; i < n; i++) {
+    out[i] = st->buckets[(first + i) % size];
+  }
+  xSemaphoreGive(history_mutex);
+  return n;
+}
+
+uint32_t climate_history_version(void) { return history_version; }
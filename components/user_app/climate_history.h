@@ -0,0 +1,68 @@
+#ifndef CLIMATE_HISTORY_H
+#define CLIMATE_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Values are stored as fixed point hundredths (23.45 C -> 2345)
+#define HISTORY_SCALE 100
+
+typedef enum {
+  HISTORY_TEMP_C = 0,
+  HISTORY_HUMIDITY,
+  HISTORY_BATTERY,
+  HISTORY_SERIES_COUNT
+} history_series_t;
+
+// Resolution levels; each closed bucket of one level feeds the next
+typedef enum {
+  HISTORY_1MIN = 0, // 60 buckets: last hour
+  HISTORY_10MIN,    // 144 buckets: last day
+  HISTORY_1HOUR,    // 168 buckets: last week
+  HISTORY_LEVEL_COUNT
+} history_level_t;
+
+#define HISTORY_MAX_BUCKETS 168
+
+typedef struct {
+  int16_t min;
+  int16_t max;
+  int16_t mean;
+} history_bucket_t;
+
+/**
+ * @brief Initialize the history store
+ */
+void climate_history_init(void);
+
+/**
+ * @brief Record a sample; O(1)
+ * @param series Which series the sample belongs to
+ * @param value Sample in natural units (C, %RH, %)
+ * @param now_s Monotonic time in seconds
+ */
+void climate_history_add(history_series_t series, float value, uint32_t now_s);
+
+/**
+ * @brief Copy the closed buckets of one level, oldest first
+ * @param out Output array
+ * @param max Capacity of out
+ * @return Number of buckets copied
+ */
+int climate_history_read(history_series_t series, history_level_t level,
+                         history_bucket_t *out, int max);
+
+/**
+ * @brief Incremented whenever a bucket closes; cheap change check for the UI
+ */
+uint32_t climate_history_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CLIMATE_HISTORY_H
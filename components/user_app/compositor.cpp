@@ -0,0 +1,92 @@
+#include "compositor.h"
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <string.h>
+
+static const char *TAG = "Compositor";
+
+static DisplayPort *panel = NULL;
+static bool baked = false;
+
+void compositor_init(DisplayPort *display) { panel = display; }
+
+bool compositor_bake(lv_obj_t *layer) {
+#if COMPOSITOR_ENABLE
+  if (!panel || !layer)
+    return false;
+
+  // Snapshot with alpha so untouched pixels stay transparent instead of
+  // coming out as black (the snapshot buffer starts zeroed)
+  lv_obj_update_layout(layer);
+  uint32_t size =
+      lv_snapshot_buf_size_needed(layer, LV_IMG_CF_TRUE_COLOR_ALPHA);
+  uint8_t *buf = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  lv_img_dsc_t snap;
+  if (!buf || lv_snapshot_take_to_buf(layer, LV_IMG_CF_TRUE_COLOR_ALPHA, &snap,
+                                      buf, size) != LV_RES_OK) {
+    ESP_LOGW(TAG, "Static layer snapshot failed, drawing it live");
+    heap_caps_free(buf);
+    return false;
+  }
+
+  // The snapshot covers the layer's coords grown by its extra draw size
+  lv_area_t area;
+  lv_obj_get_coords(layer, &area);
+  lv_coord_t ext = _lv_obj_get_ext_draw_size(layer);
+  lv_area_increase(&area, ext, ext);
+
+  lv_disp_t *disp = lv_obj_get_disp(layer);
+  lv_coord_t hor = lv_disp_get_hor_res(disp);
+  lv_coord_t ver = lv_disp_get_ver_res(disp);
+
+  panel->RLCD_BackgroundClear();
+  int black = 0;
+  const uint8_t *px = buf;
+  for (int y = 0; y < snap.header.h; y++) {
+    for (int x = 0; x < snap.header.w; x++, px += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+      lv_color_t color;
+      memcpy(&color, px, sizeof(color));
+      lv_opa_t opa = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+      int sx = area.x1 + x;
+      int sy = area.y1 + y;
+      // Same threshold as a live render over white
+      if (opa >= LV_OPA_50 && color.full < 0x7fff && sx >= 0 && sy >= 0 &&
+          sx < hor && sy < ver) {
+        panel->RLCD_SetBackgroundPixel(sx, sy, ColorBlack);
+        black++;
+      }
+    }
+  }
+  heap_caps_free(buf);
+
+  // Hiding invalidates the layer, so the next frame blends the plane in
+  lv_obj_add_flag(layer, LV_OBJ_FLAG_HIDDEN);
+  baked = true;
+  ESP_LOGI(TAG, "Static layer baked: %dx%d, %d black px", snap.header.w,
+           snap.header.h, black);
+  return true;
+#else
+  (void)layer;
+  return false;
+#endif
+}
+
+void compositor_flush(const lv_area_t *area, const lv_color_t *color_map) {
+  const uint16_t *buffer = (const uint16_t *)color_map;
+  for (int y = area->y1; y <= area->y2; y++) {
+    for (int x = area->x1; x <= area->x2; x++) {
+      uint8_t color = (*buffer < 0x7fff) ? ColorBlack : ColorWhite;
+      panel->RLCD_SetPixel(x, y, color);
+      buffer++;
+    }
+  }
+
+#if COMPOSITOR_ENABLE
+  if (baked) {
+    panel->RLCD_BlendBackground(area->x1, area->y1, area->x2, area->y2);
+  }
+  panel->RLCD_DisplayArea(area->x1, area->y1, area->x2, area->y2);
+#else
+  panel->RLCD_Display();
+#endif
+}
@@ -0,0 +1,31 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "display_bsp.h"
+#include "lvgl.h"
+#include <stdbool.h>
+
+// 1: bake the dashboard's static layer into the panel's background plane and
+// send flushed areas as panel windows. 0: plain full-frame transfers.
+#define COMPOSITOR_ENABLE 1
+
+/**
+ * @brief Attach the panel; call before Lvgl_PortInit()
+ */
+void compositor_init(DisplayPort *panel);
+
+/**
+ * @brief Render a layer once into the packed background plane and hide it
+ * @note Call with the LVGL lock held, after the layer's objects are created.
+ * The layer must be opaque black-on-white only where nothing dynamic draws.
+ * @return false if the snapshot failed; the layer then stays live in LVGL
+ */
+bool compositor_bake(lv_obj_t *layer);
+
+/**
+ * @brief Flush callback body: pack one rendered LVGL area into the panel
+ * buffer, blend the background under it and send it
+ */
+void compositor_flush(const lv_area_t *area, const lv_color_t *color_map);
+
+#endif // COMPOSITOR_H
@@ -0,0 +1,225 @@
+#include "dashboard_model.h"
+#include "lvgl_bsp.h"
+#include <esp_log.h>
+#include <math.h>
+#include <string.h>
+
+static const char *TAG = "DashModel";
+
+typedef struct {
+  int8_t hours;
+  int8_t minutes;
+  bool colon;
+  char date[32];
+  int8_t synced; // -1 until first set
+  int16_t temp_df; // 0.1 F
+  int8_t humidity; // %
+  uint8_t battery; // %
+  int8_t wifi_bars;
+  game_info_t games[2];
+  int8_t game_count;
+  int8_t stale; // -1 until first set
+  int stale_age_min;
+} dashboard_view_t;
+
+static dashboard_view_t view;
+static uint32_t dirty = 0;
+static dashboard_model_stats_t stats;
+
+// One-shot and by-reference fields
+static uint32_t highlight_id = 0;
+static const int16_t *history_temp = NULL;
+static const int16_t *history_humidity = NULL;
+static int history_temp_count = 0;
+static int history_humidity_count = 0;
+
+static const char *const FIELD_NAMES[DM_FIELD_COUNT] = {
+    "time",    "date", "synced", "climate", "history", "battery",
+    "wifi",    "scores", "stale", "highlight", "logos",
+};
+
+// Record whether a setter changed its field
+static void mark(dashboard_field_t field, bool changed) {
+  if (changed) {
+    dirty |= 1u << field;
+  } else {
+    stats.suppressed[field]++;
+  }
+}
+
+static bool same_game(const game_info_t *a, const game_info_t *b) {
+  return a->id == b->id && a->away_team == b->away_team &&
+         a->home_team == b->home_team && a->away_score == b->away_score &&
+         a->home_score == b->home_score && a->is_live == b->is_live &&
+         strcmp(a->status, b->status) == 0;
+}
+
+void dashboard_model_init(void) {
+  memset(&view, 0, sizeof(view));
+  view.hours = -1;
+  view.battery = 255;
+  view.wifi_bars = -1;
+  view.temp_df = INT16_MIN;
+  view.humidity = -1;
+  view.game_count = -1;
+  view.synced = -1;
+  view.stale = -1;
+  dirty = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void dashboard_model_set_time(int hours, int minutes, bool colon_visible) {
+  bool changed = view.hours != hours || view.minutes != minutes ||
+                 view.colon != colon_visible;
+  view.hours = hours;
+  view.minutes = minutes;
+  view.colon = colon_visible;
+  mark(DM_TIME, changed);
+}
+
+void dashboard_model_set_date(const char *date_str) {
+  bool changed = strncmp(view.date, date_str, sizeof(view.date) - 1) != 0;
+  if (changed) {
+    strncpy(view.date, date_str, sizeof(view.date) - 1);
+    view.date[sizeof(view.date) - 1] = '\0';
+  }
+  mark(DM_DATE, changed);
+}
+
+void dashboard_model_set_clock_synced(bool synced) {
+  bool changed = view.synced != (int8_t)synced;
+  view.synced = synced;
+  mark(DM_SYNCED, changed);
+}
+
+void dashboard_model_set_climate(float temp_c, float humidity) {
+  int16_t temp_df = (int16_t)lroundf((temp_c * 9.0f / 5.0f + 32.0f) * 10.0f);
+  int8_t rh = (int8_t)lroundf(humidity);
+  bool changed = view.temp_df != temp_df || view.humidity != rh;
+  view.temp_df = temp_df;
+  view.humidity = rh;
+  mark(DM_CLIMATE, changed);
+}
+
+void dashboard_model_set_history(const int16_t *temp, int temp_count,
+                                 const int16_t *humidity,
+                                 int humidity_count) {
+  // Callers only push a series when a history bucket closed
+  history_temp = temp;
+  history_temp_count = temp_count;
+  history_humidity = humidity;
+  history_humidity_count = humidity_count;
+  mark(DM_HISTORY, true);
+}
+
+void dashboard_model_set_battery(uint8_t percent) {
+  if (percent > 100)
+    percent = 100;
+  bool changed = view.battery != percent;
+  view.battery = percent;
+  mark(DM_BATTERY, changed);
+}
+
+void dashboard_model_set_wifi(int8_t rssi, bool connected) {
+  int8_t bars = (int8_t)dashboard_wifi_bars(rssi, connected);
+  bool changed = view.wifi_bars != bars;
+  view.wifi_bars = bars;
+  mark(DM_WIFI, changed);
+}
+
+void dashboard_model_set_scores(const game_info_t *games, int count) {
+  if (count < 0)
+    count = 0;
+  if (count > 2)
+    count = 2;
+  bool changed = view.game_count != count;
+  for (int i = 0; i < count && !changed; i++) {
+    changed = !same_game(&view.games[i], &games[i]);
+  }
+  if (changed) {
+    memcpy(view.games, games, count * sizeof(game_info_t));
+    view.game_count = count;
+  }
+  mark(DM_SCORES, changed);
+}
+
+void dashboard_model_set_scores_stale(bool stale, int age_min) {
+  if (!stale)
+    age_min = -1;
+  bool changed = view.stale != (int8_t)stale || view.stale_age_min != age_min;
+  view.stale = stale;
+  view.stale_age_min = age_min;
+  mark(DM_STALE, changed);
+}
+
+void dashboard_model_highlight(uint32_t game_id) {
+  highlight_id = game_id;
+  mark(DM_HIGHLIGHT, true);
+}
+
+void dashboard_model_refresh_logos(void) { mark(DM_LOGOS, true); }
+
+bool dashboard_model_dirty(void) { return dirty != 0; }
+
+void dashboard_model_log_stats(void) {
+  uint32_t applied = 0, suppressed = 0;
+  for (int i = 0; i < DM_FIELD_COUNT; i++) {
+    applied += stats.applied[i];
+    suppressed += stats.suppressed[i];
+  }
+  ESP_LOGI(TAG, "%u commits, %u field updates applied, %u suppressed",
+           (unsigned)stats.commits, (unsigned)applied, (unsigned)suppressed);
+  for (int i = 0; i < DM_FIELD_COUNT; i++) {
+    if (stats.applied[i] || stats.suppressed[i]) {
+      ESP_LOGD(TAG, "  %-9s %6u applied %6u suppressed", FIELD_NAMES[i],
+               (unsigned)stats.applied[i], (unsigned)stats.suppressed[i]);
+    }
+  }
+}
+
+bool dashboard_commit(int timeout_ms) {
+  if (!dirty)
+    return true;
+  if (!Lvgl_lock(timeout_ms))
+    return false;
+
+  uint32_t fields = dirty;
+  dirty = 0;
+
+  if (fields & (1u << DM_TIME))
+    dashboard_update_time(view.hours, view.minutes, view.colon);
+  if (fields & (1u << DM_DATE))
+    dashboard_update_date(view.date);
+  if (fields & (1u << DM_SYNCED))
+    dashboard_set_clock_synced(view.synced > 0);
+  if (fields & (1u << DM_CLIMATE))
+    dashboard_update_climate(view.temp_df / 10.0f, (float)view.humidity);
+  if (fields & (1u << DM_HISTORY))
+    dashboard_update_climate_history(history_temp, history_temp_count,
+                                     history_humidity,
+                                     history_humidity_count);
+  if (fields & (1u << DM_BATTERY))
+    dashboard_update_battery(view.battery);
+  if (fields & (1u << DM_WIFI))
+    dashboard_set_wifi_bars(view.wifi_bars);
+  if (fields & (1u << DM_SCORES))
+    dashboard_update_scores(view.games, view.game_count);
+  if (fields & (1u << DM_STALE))
+    dashboard_set_scores_stale(view.stale > 0, view.stale_age_min);
+  // After the scores, so a new game's label is highlighted
+  if (fields & (1u << DM_HIGHLIGHT))
+    dashboard_highlight_game(highlight_id);
+  if (fields & (1u << DM_LOGOS))
+    dashboard_refresh_logos();
+
+  Lvgl_unlock();
+
+  stats.commits++;
+  for (int i = 0; i < DM_FIELD_COUNT; i++) {
+    if (fields & (1u << i))
+      stats.applied[i]++;
+  }
+  return true;
+}
+
+void dashboard_model_get_stats(dashboard_model_stats_t *out) { *out = stats; }
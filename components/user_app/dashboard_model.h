@@ -0,0 +1,108 @@
+#ifndef DASHBOARD_MODEL_H
+#define DASHBOARD_MODEL_H
+
+#include "dashboard_screen.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// View-model between the data sources and the dashboard widgets. Setters
+// quantize to what the screen shows and mark a field dirty only if that
+// changed; dashboard_commit() applies the dirty fields under one short LVGL
+// lock. Setters and commit belong to the dashboard task (no locking).
+
+#define DASHBOARD_STATS_PERIOD_MS (10 * 60 * 1000) // Dashboard task's stats job
+
+typedef enum {
+  DM_TIME,
+  DM_DATE,
+  DM_SYNCED,
+  DM_CLIMATE,
+  DM_HISTORY,
+  DM_BATTERY,
+  DM_WIFI,
+  DM_SCORES,
+  DM_STALE,
+  DM_HIGHLIGHT,
+  DM_LOGOS,
+  DM_FIELD_COUNT
+} dashboard_field_t;
+
+typedef struct {
+  uint32_t commits;                   // dashboard_commit() calls that drew
+  uint32_t applied[DM_FIELD_COUNT];   // Field updates pushed to widgets
+  uint32_t suppressed[DM_FIELD_COUNT]; // Setter calls with nothing new
+} dashboard_model_stats_t;
+
+/**
+ * @brief Mark every field unknown, so the first values are all applied
+ */
+void dashboard_model_init(void);
+
+void dashboard_model_set_time(int hours, int minutes, bool colon_visible);
+void dashboard_model_set_date(const char *date_str);
+void dashboard_model_set_clock_synced(bool synced);
+
+/**
+ * @brief Climate reading, kept as 0.1 F and 1 % (the displayed precision)
+ */
+void dashboard_model_set_climate(float temp_c, float humidity);
+
+/**
+ * @brief Sparkline series; the arrays must stay valid until the commit
+ */
+void dashboard_model_set_history(const int16_t *temp, int temp_count,
+                                 const int16_t *humidity, int humidity_count);
+
+void dashboard_model_set_battery(uint8_t percent);
+
+/**
+ * @brief WiFi state, kept as the bar count
+ */
+void dashboard_model_set_wifi(int8_t rssi, bool connected);
+
+void dashboard_model_set_scores(const game_info_t *games, int count);
+
+/**
+ * @brief Snapshot tag on the scores; the age (minutes, -1 if unknown) is
+ * only kept while stale
+ */
+void dashboard_model_set_scores_stale(bool stale, int age_min);
+
+/**
+ * @brief One-shot: invert a game's score label ("just scored")
+ */
+void dashboard_model_highlight(uint32_t game_id);
+
+/**
+ * @brief One-shot: retry logos that were still downloading
+ */
+void dashboard_model_refresh_logos(void);
+
+/**
+ * @return true if a commit would change anything
+ */
+bool dashboard_model_dirty(void);
+
+/**
+ * @brief Apply the dirty fields to the widgets
+ * @param timeout_ms LVGL lock timeout; on timeout the fields stay dirty
+ * @return false if the lock could not be taken
+ */
+bool dashboard_commit(int timeout_ms);
+
+void dashboard_model_get_stats(dashboard_model_stats_t *stats);
+
+/**
+ * @brief Log the commit and suppression counters (per field at debug level)
+ */
+void dashboard_model_log_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DASHBOARD_MODEL_H
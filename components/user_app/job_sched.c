@@ -0,0 +1,99 @@
+#include "job_sched.h"
+#include "esp_timer.h"
+#include <esp_log.h>
+#include <string.h>
+
+static const char *TAG = "Sched";
+
+// A handful of jobs per task: linear scans are cheaper than keeping a heap
+
+void sched_init(job_sched_t *sched, const char *name) {
+  memset(sched, 0, sizeof(*sched));
+  sched->name = name;
+}
+
+int sched_add(job_sched_t *sched, const char *name, sched_job_fn_t fn,
+              void *ctx, uint32_t period_ms, uint32_t jitter_ms) {
+  if (sched->count >= SCHED_MAX_JOBS || period_ms == 0)
+    return -1;
+  sched_job_t *job = &sched->jobs[sched->count];
+  memset(job, 0, sizeof(*job));
+  job->name = name;
+  job->fn = fn;
+  job->ctx = ctx;
+  job->period_ms = period_ms;
+  job->jitter_ms = jitter_ms;
+  job->deadline_us = esp_timer_get_time();
+  return sched->count++;
+}
+
+int sched_run(job_sched_t *sched) {
+  int ran = 0;
+  for (int i = 0; i < sched->count; i++) {
+    sched_job_t *job = &sched->jobs[i];
+    int64_t start = esp_timer_get_time();
+    if (start < job->deadline_us)
+      continue;
+
+    job->fn(job->ctx);
+    int64_t end = esp_timer_get_time();
+    ran++;
+
+    uint32_t late = (uint32_t)(start - job->deadline_us);
+    uint32_t took = (uint32_t)(end - start);
+    job->runs++;
+    job->late_us_total += late;
+    job->run_us_total += took;
+    if (late > job->late_us_max)
+      job->late_us_max = late;
+    if (took > job->run_us_max)
+      job->run_us_max = took;
+
+    // Next deadline on the original grid. A deadline already past but still
+    // inside its jitter window just runs on the next pass; only periods whose
+    // window has closed are dropped rather than run back to back
+    int64_t period_us = (int64_t)job->period_ms * 1000;
+    int64_t jitter_us = (int64_t)job->jitter_ms * 1000;
+    job->deadline_us += period_us;
+    if (job->deadline_us + jitter_us < end) {
+      int64_t missed = (end - job->deadline_us - jitter_us) / period_us + 1;
+      job->deadline_us += missed * period_us;
+      job->skipped += (uint32_t)missed;
+    }
+  }
+  return ran;
+}
+
+TickType_t sched_ticks_to_wait(const job_sched_t *sched) {
+  if (sched->count == 0)
+    return portMAX_DELAY;
+
+  int64_t wake = INT64_MAX;
+  for (int i = 0; i < sched->count; i++) {
+    const sched_job_t *job = &sched->jobs[i];
+    int64_t limit = job->deadline_us + (int64_t)job->jitter_ms * 1000;
+    if (limit < wake)
+      wake = limit;
+  }
+
+  int64_t wait_us = wake - esp_timer_get_time();
+  if (wait_us <= 0)
+    return 0;
+  // Round up: waking a tick early would find nothing due
+  const int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+  return (TickType_t)((wait_us + tick_us - 1) / tick_us);
+}
+
+void sched_log_stats(const job_sched_t *sched) {
+  ESP_LOGI(TAG, "%s: %-10s %6s %8s %8s %8s %8s %5s", sched->name, "job",
+           "runs", "avg_us", "max_us", "late_ms", "max_ms", "skip");
+  for (int i = 0; i < sched->count; i++) {
+    const sched_job_t *job = &sched->jobs[i];
+    uint32_t runs = job->runs ? job->runs : 1;
+    ESP_LOGI(TAG, "%s: %-10s %6u %8u %8u %8.1f %8.1f %5u", sched->name,
+             job->name, (unsigned)job->runs,
+             (unsigned)(job->run_us_total / runs), (unsigned)job->run_us_max,
+             job->late_us_total / runs / 1000.0, job->late_us_max / 1000.0,
+             (unsigned)job->skipped);
+  }
+}
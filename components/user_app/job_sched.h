@@ -0,0 +1,78 @@
+#ifndef JOB_SCHED_H
+#define JOB_SCHED_H
+
+#include <freertos/FreeRTOS.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deadline scheduler for one task's periodic jobs. Deadlines are absolute
+// (esp_timer time) and advance by whole periods, so run time never makes
+// a job drift. A job may run up to jitter_ms late; the owning task sleeps
+// until the earliest such limit and then runs every job already due, so
+// jobs with overlapping windows share one wake-up.
+
+#define SCHED_MAX_JOBS 8
+
+typedef void (*sched_job_fn_t)(void *ctx);
+
+typedef struct {
+  const char *name;
+  sched_job_fn_t fn;
+  void *ctx;
+  uint32_t period_ms;
+  uint32_t jitter_ms;
+  int64_t deadline_us;
+
+  uint32_t runs;
+  uint32_t skipped; // Whole periods missed (task blocked for too long)
+  int64_t run_us_total;
+  uint32_t run_us_max;
+  int64_t late_us_total;
+  uint32_t late_us_max;
+} sched_job_t;
+
+typedef struct {
+  const char *name; // For the stats log
+  sched_job_t jobs[SCHED_MAX_JOBS];
+  int count;
+} job_sched_t;
+
+void sched_init(job_sched_t *sched, const char *name);
+
+/**
+ * @brief Add a periodic job; its first run is due immediately
+ * @param name Static string, shown in the stats
+ * @param period_ms Time between deadlines
+ * @param jitter_ms How late a run may be, to share a wake-up with others;
+ * keep it below period_ms, or the lateness stats just show the window
+ * @return Job index, -1 if the table is full
+ */
+int sched_add(job_sched_t *sched, const char *name, sched_job_fn_t fn,
+              void *ctx, uint32_t period_ms, uint32_t jitter_ms);
+
+/**
+ * @brief Run every job whose deadline has passed, in table order
+ * @return Number of jobs run
+ */
+int sched_run(job_sched_t *sched);
+
+/**
+ * @brief Ticks to sleep before a job would be later than its jitter allows
+ * @return 0 if something is already overdue, portMAX_DELAY with no jobs
+ */
+TickType_t sched_ticks_to_wait(const job_sched_t *sched);
+
+/**
+ * @brief Log runs, run time and lateness per job
+ */
+void sched_log_stats(const job_sched_t *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOB_SCHED_H
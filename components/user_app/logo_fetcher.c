@@ -1,9 +1,11 @@
 #include "logo_fetcher.h"
-#include "esp_crt_bundle.h"
 #include "esp_heap_caps.h"
-#include "esp_http_client.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "lvgl.h"
+#include "net_service.h"
 #include <string.h>
 #include <sys/stat.h>
 
@@ -32,7 +34,7 @@ static const char *TAG = "LogoFetcher";
 // In-memory cache for loaded logos (avoid repeated SD reads)
 #define MAX_CACHED_LOGOS 8
 typedef struct {
-  char team_id[16];
+  uint32_t team_id;
   uint8_t *data;
   int width;
   int height;
@@ -42,6 +44,29 @@ typedef struct {
 static cached_logo_t logo_cache[MAX_CACHED_LOGOS];
 static int cache_count = 0;
 
+// Guards logo_cache and failed_logos; downloads complete on the network task
+static SemaphoreHandle_t cache_mutex = NULL;
+
+// Largest combiner PNG accepted (72x72 logos are well under this)
+#define LOGO_MAX_PNG_SIZE (32 * 1024)
+
+// Failed downloads are not retried for a while (e.g. missing logos)
+#define LOGO_RETRY_MS (5 * 60 * 1000)
+#define MAX_FAILED_LOGOS 8
+typedef struct {
+  uint32_t team_id;
+  TickType_t tick;
+} failed_logo_t;
+
+static failed_logo_t failed_logos[MAX_FAILED_LOGOS];
+static int failed_next = 0;
+
+// Teams known to have a logo file on SD, by registry handle
+static uint8_t on_sd[MAX_TEAMS / 8];
+
+static logo_ready_cb_t ready_cb = NULL;
+static void *ready_ctx = NULL;
+
 // Flag to track if SD card is available
 static bool sd_available = false;
 
@@ -54,6 +79,9 @@ void logo_fetcher_init(void) {
   // Initialize in-memory cache
   memset(logo_cache, 0, sizeof(logo_cache));
   cache_count = 0;
+  if (!cache_mutex) {
+    cache_mutex = xSemaphoreCreateMutex();
+  }
 
   // Check if SD card is mounted and create logos directory
   struct stat st;
@@ -77,67 +105,21 @@ void logo_fetcher_init(void) {
            sd_available ? "enabled" : "disabled");
 }
 
-// Extract team ID from ESPN logo URL
-// URL format: https://a.espncdn.com/i/teamlogos/ncaa/500/145.png
-// Or combiner:
-// https://a.espncdn.com/combiner/i?img=/i/teamlogos/ncaa/500/145.png&...
-static bool extract_team_id(const char *url, char *team_id, size_t max_len) {
-  // Find last '/' before '.png'
-  const char *png = strstr(url, ".png");
-  if (!png)
-    return false;
-
-  const char *last_slash = NULL;
-  for (const char *p = url; p < png; p++) {
-    if (*p == '/')
-      last_slash = p;
-  }
-
-  if (!last_slash)
-    return false;
-
-  size_t id_len = png - last_slash - 1;
-  if (id_len >= max_len || id_len == 0)
-    return false;
-
-  strncpy(team_id, last_slash + 1, id_len);
-  team_id[id_len] = '\0';
-  return true;
-}
-
 // Build ESPN combiner URL for properly scaled images
-// Transforms: https://a.espncdn.com/i/teamlogos/ncaa/500/145.png
+// Transforms: /i/teamlogos/ncaa/500/145.png
 // To:
 // https://a.espncdn.com/combiner/i?img=/i/teamlogos/ncaa/500/145.png&w=72&h=72&transparent=true
-static void build_combiner_url(const char *original_url, char *combiner_url,
+static void build_combiner_url(const char *logo_path, char *combiner_url,
                                size_t max_len) {
-  // Look for the path after espncdn.com
-  const char *cdn = strstr(original_url, "espncdn.com");
-  if (!cdn) {
-    // Fallback to original URL
-    strncpy(combiner_url, original_url, max_len - 1);
-    combiner_url[max_len - 1] = '\0';
-    return;
-  }
-
-  // Find the path starting with /i/
-  const char *path = strstr(cdn, "/i/");
-  if (!path) {
-    strncpy(combiner_url, original_url, max_len - 1);
-    combiner_url[max_len - 1] = '\0';
-    return;
-  }
-
-  // Build new URL with combiner
   snprintf(combiner_url, max_len,
            "https://a.espncdn.com/combiner/i?img=%s&w=72&h=72&transparent=true",
-           path);
+           logo_path);
 }
 
-// Check in-memory cache for a logo
-static cached_logo_t *find_cached_logo(const char *team_id) {
+// Check in-memory cache for a logo (cache_mutex held)
+static cached_logo_t *find_cached_logo(uint32_t team_id) {
   for (int i = 0; i < cache_count; i++) {
-    if (strcmp(logo_cache[i].team_id, team_id) == 0 && logo_cache[i].valid) {
+    if (logo_cache[i].team_id == team_id && logo_cache[i].valid) {
       return &logo_cache[i];
     }
   }
@@ -145,8 +127,9 @@ static cached_logo_t *find_cached_logo(const char *team_id) {
 }
 
 // Add logo to in-memory cache
-static void add_to_cache(const char *team_id, uint8_t *data, int width,
+static void add_to_cache(uint32_t team_id, uint8_t *data, int width,
                          int height) {
+  xSemaphoreTake(cache_mutex, portMAX_DELAY);
   if (cache_count >= MAX_CACHED_LOGOS) {
     // Cache full, evict oldest
     if (logo_cache[0].data) {
@@ -162,23 +145,56 @@ static void add_to_cache(const char *team_id, uint8_t *data, int width,
   uint8_t *cache_data = heap_caps_malloc(data_size, MALLOC_CAP_SPIRAM);
   if (cache_data) {
     memcpy(cache_data, data, data_size);
-    strncpy(logo_cache[cache_count].team_id, team_id, 15);
-    logo_cache[cache_count].team_id[15] = '\0';
+    logo_cache[cache_count].team_id = team_id;
     logo_cache[cache_count].data = cache_data;
     logo_cache[cache_count].width = width;
     logo_cache[cache_count].height = height;
     logo_cache[cache_count].valid = true;
     cache_count++;
   }
+  xSemaphoreGive(cache_mutex);
 }
 
 // Build cache file path for a team ID
-static void build_cache_path(const char *team_id, char *path, size_t max_len) {
-  snprintf(path, max_len, "%s/%s_70.rgb", LOGO_CACHE_DIR, team_id);
+static void build_cache_path(uint32_t team_id, char *path, size_t max_len) {
+  snprintf(path, max_len, "%s/%lu_70.rgb", LOGO_CACHE_DIR,
+           (unsigned long)team_id);
+}
+
+static bool is_on_sd(team_handle_t team) {
+  return team < MAX_TEAMS && (on_sd[team / 8] & (1 << (team % 8)));
+}
+
+static void mark_on_sd(team_handle_t team) {
+  if (team < MAX_TEAMS)
+    __atomic_fetch_or(&on_sd[team / 8], 1 << (team % 8), __ATOMIC_RELAXED);
+}
+
+static bool recently_failed(uint32_t team_id) {
+  bool failed = false;
+  TickType_t now = xTaskGetTickCount();
+  xSemaphoreTake(cache_mutex, portMAX_DELAY);
+  for (int i = 0; i < MAX_FAILED_LOGOS; i++) {
+    if (failed_logos[i].team_id == team_id &&
+        now - failed_logos[i].tick < pdMS_TO_TICKS(LOGO_RETRY_MS)) {
+      failed = true;
+      break;
+    }
+  }
+  xSemaphoreGive(cache_mutex);
+  return failed;
+}
+
+static void mark_failed(uint32_t team_id) {
+  xSemaphoreTake(cache_mutex, portMAX_DELAY);
+  failed_logos[failed_next].team_id = team_id;
+  failed_logos[failed_next].tick = xTaskGetTickCount();
+  failed_next = (failed_next + 1) % MAX_FAILED_LOGOS;
+  xSemaphoreGive(cache_mutex);
 }
 
 // Try to load cached logo from SD card
-static bool load_sd_cached_logo(const char *team_id, logo_data_t *out_logo) {
+static bool load_sd_cached_logo(uint32_t team_id, logo_data_t *out_logo) {
   if (!sd_available)
     return false;
 
@@ -228,7 +244,7 @@ static bool load_sd_cached_logo(const char *team_id, logo_data_t *out_logo) {
 }
 
 // Save logo to SD card cache
-static bool save_sd_cached_logo(const char *team_id, logo_data_t *logo) {
+static bool save_sd_cached_logo(uint32_t team_id, logo_data_t *logo) {
   if (!sd_available || !logo->valid)
     return false;
 
@@ -276,8 +292,8 @@ static void flip_vertical(unsigned char *rgba, int width, int height) {
 // Convert RGBA to grayscale RGB565 with alpha blending to white background
 // Special handling: team 2633 renders all opaque pixels as black (silhouette)
 static void convert_to_grayscale(unsigned char *rgba, int width, int height,
-                                 uint16_t *rgb565_out, const char *team_id) {
-  bool render_black = (team_id && strcmp(team_id, "2633") == 0);
+                                 uint16_t *rgb565_out, uint32_t team_id) {
+  bool render_black = (team_id == 2633);
 
   for (int i = 0; i < width * height; i++) {
     int idx = i * 4;
@@ -309,125 +325,16 @@ static void convert_to_grayscale(unsigned char *rgba, int width, int height,
   }
 }
 
-bool logo_fetcher_get(const char *url, logo_data_t *out_logo) {
-  if (!url || !url[0] || !out_logo) {
-    return false;
-  }
-
-  memset(out_logo, 0, sizeof(logo_data_t));
-
-  // Extract team ID from URL
-  char team_id[16];
-  if (!extract_team_id(url, team_id, sizeof(team_id))) {
-    ESP_LOGW(TAG, "Could not extract team ID from URL");
-    return false;
-  }
-
-  // Check in-memory cache first (fastest)
-  cached_logo_t *cached = find_cached_logo(team_id);
-  if (cached) {
-    // Return a copy of cached data
-    size_t data_size = cached->width * cached->height * sizeof(uint16_t);
-    uint8_t *data_copy = heap_caps_malloc(data_size, MALLOC_CAP_SPIRAM);
-    if (data_copy) {
-      memcpy(data_copy, cached->data, data_size);
-      out_logo->data = data_copy;
-      out_logo->width = cached->width;
-      out_logo->height = cached->height;
-      out_logo->valid = true;
-      return true;
-    }
-  }
-
-  // Try to load from SD card cache
-  if (load_sd_cached_logo(team_id, out_logo)) {
-    ESP_LOGI(TAG, "Loaded cached logo: %s (%dx%d)", team_id, out_logo->width,
-             out_logo->height);
-    // Add to in-memory cache for faster subsequent loads
-    add_to_cache(team_id, out_logo->data, out_logo->width, out_logo->height);
-    return true;
-  }
-
-#if !LV_USE_PNG
-  ESP_LOGW(TAG, "PNG support not enabled (LV_USE_PNG=n)");
-  return false;
-#else
-
-  // Build combiner URL for pre-scaled 72x72 image
-  char combiner_url[256];
-  build_combiner_url(url, combiner_url, sizeof(combiner_url));
-
-  // Download logo from combiner URL (pre-scaled to 72x72)
-  char *png_buffer = NULL;
-  int png_size = 0;
-  int png_cap =
-      32 * 1024; // 32KB max for 72x72 logo (much smaller than 500x500)
-
-  ESP_LOGI(TAG, "Downloading logo for team %s...", team_id);
-
-  esp_http_client_config_t config = {
-      .url = combiner_url,
-      .timeout_ms = 15000,
-      .crt_bundle_attach = esp_crt_bundle_attach,
-  };
-
-  esp_http_client_handle_t client = esp_http_client_init(&config);
-  esp_err_t err = esp_http_client_open(client, 0);
-
-  if (err != ESP_OK) {
-    ESP_LOGE(TAG, "Failed to open HTTP connection: %s", esp_err_to_name(err));
-    esp_http_client_cleanup(client);
-    return false;
-  }
-
-  int content_length = esp_http_client_fetch_headers(client);
-  if (content_length < 0) {
-    content_length = png_cap;
-  } else if (content_length > png_cap) {
-    ESP_LOGW(TAG, "Logo too large (%d bytes), skipping", content_length);
-    esp_http_client_close(client);
-    esp_http_client_cleanup(client);
-    return false;
-  }
-
-  png_buffer = heap_caps_malloc(png_cap, MALLOC_CAP_SPIRAM);
-  if (!png_buffer) {
-    ESP_LOGE(TAG, "Failed to allocate image buffer");
-    esp_http_client_close(client);
-    esp_http_client_cleanup(client);
-    return false;
-  }
-
-  // Read image data
-  while (png_size < png_cap) {
-    int read_len =
-        esp_http_client_read(client, png_buffer + png_size, png_cap - png_size);
-    if (read_len <= 0) {
-      break;
-    }
-    png_size += read_len;
-  }
-
-  esp_http_client_close(client);
-  esp_http_client_cleanup(client);
-
-  if (png_size < 100) { // Minimum valid PNG size
-    ESP_LOGE(TAG, "Invalid response - only %d bytes received", png_size);
-    free(png_buffer);
-    return false;
-  }
-
-  ESP_LOGI(TAG, "Downloaded %d bytes", png_size);
-
+#if LV_USE_PNG
+// Decode a downloaded PNG into a grayscale RGB565 logo
+static bool decode_logo(uint32_t team_id, const char *png, int png_size,
+                        logo_data_t *out_logo) {
   // Decode PNG using LodePNG (will use our custom SPIRAM allocators)
   unsigned char *decoded_data = NULL;
   unsigned width = 0, height = 0;
 
   unsigned error = lodepng_decode32(&decoded_data, &width, &height,
-                                    (unsigned char *)png_buffer, png_size);
-
-  free(png_buffer);
-
+                                    (const unsigned char *)png, png_size);
   if (error) {
     ESP_LOGE(TAG, "PNG decode error: %s", lodepng_error_text(error));
     return false;
@@ -490,7 +397,7 @@ bool logo_fetcher_get(const char *url, logo_data_t *out_logo) {
   }
 
   // Special case: flip team 251 vertically
-  if (strcmp(team_id, "251") == 0) {
+  if (team_id == 251) {
     flip_vertical(scaled_data, out_width, out_height);
   }
 
@@ -505,13 +412,152 @@ bool logo_fetcher_get(const char *url, logo_data_t *out_logo) {
   out_logo->valid = true;
 
   ESP_LOGI(TAG, "Converted to %dx%d RGB565 (grayscale)", out_width, out_height);
+  return true;
+}
 
-  // Save to SD card cache for next time
-  save_sd_cached_logo(team_id, out_logo);
+// Runs on the network task when a logo download finishes
+static void logo_download_done(const net_response_t *resp, void *ctx) {
+  team_handle_t team = (team_handle_t)(uintptr_t)ctx;
+  const team_info_t *info = team_registry_get(team);
+  if (!info)
+    return;
 
-  // Add to in-memory cache
-  add_to_cache(team_id, out_logo->data, out_logo->width, out_logo->height);
+  uint32_t team_id = info->espn_id;
+  if (resp->err != ESP_OK || resp->status != 200 ||
+      resp->len < 100) { // Minimum valid PNG size
+    ESP_LOGE(TAG, "Logo download failed for team %lu (%d bytes, HTTP %d)",
+             (unsigned long)team_id, resp->len, resp->status);
+    mark_failed(team_id);
+    return;
+  }
 
-  return true;
+  ESP_LOGI(TAG, "Downloaded %d bytes", resp->len);
+
+  logo_data_t logo = {0};
+  if (!decode_logo(team_id, resp->body, resp->len, &logo)) {
+    mark_failed(team_id);
+    return;
+  }
+
+  // Downloads land on SD; the RAM cache fills on the next get. Without an
+  // SD card the RAM cache is the only copy.
+  if (save_sd_cached_logo(team_id, &logo)) {
+    mark_on_sd(team);
+  } else {
+    add_to_cache(team_id, logo.data, logo.width, logo.height);
+  }
+  free(logo.data);
+
+  if (ready_cb) {
+    ready_cb(team, ready_ctx);
+  }
+}
+#endif
+
+// Queue a download unless one is pending or the team failed recently
+static void request_download(team_handle_t team, const team_info_t *info,
+                             net_priority_t priority) {
+#if !LV_USE_PNG
+  ESP_LOGW(TAG, "PNG support not enabled (LV_USE_PNG=n)");
+#else
+  if (!info->logo_path[0] || recently_failed(info->espn_id)) {
+    return;
+  }
+
+  // Build combiner URL for pre-scaled 72x72 image
+  char combiner_url[NET_URL_MAX_LEN];
+  build_combiner_url(info->logo_path, combiner_url, sizeof(combiner_url));
+
+  net_request_t req = {
+      .url = combiner_url,
+      .priority = priority,
+      .key = info->espn_id, // Coalesce visible and prefetch requests
+      .max_body = LOGO_MAX_PNG_SIZE,
+      .timeout_ms = 15000,
+      .on_done = logo_download_done,
+      .ctx = (void *)(uintptr_t)team,
+  };
+  net_service_submit(&req);
 #endif
 }
+
+void logo_fetcher_set_ready_cb(logo_ready_cb_t cb, void *ctx) {
+  ready_ctx = ctx;
+  ready_cb = cb;
+}
+
+bool logo_fetcher_get(team_handle_t team, logo_data_t *out_logo) {
+  const team_info_t *info = team_registry_get(team);
+  if (!info || !out_logo) {
+    return false;
+  }
+
+  memset(out_logo, 0, sizeof(logo_data_t));
+
+  // Logos are cached by ESPN team ID
+  uint32_t team_id = info->espn_id;
+  if (team_id == 0) {
+    ESP_LOGW(TAG, "No team ID for %s", info->abbrev);
+    return false;
+  }
+
+  // Check in-memory cache first (fastest)
+  xSemaphoreTake(cache_mutex, portMAX_DELAY);
+  cached_logo_t *cached = find_cached_logo(team_id);
+  if (cached) {
+    // Return a copy of cached data
+    size_t data_size = cached->width * cached->height * sizeof(uint16_t);
+    uint8_t *data_copy = heap_caps_malloc(data_size, MALLOC_CAP_SPIRAM);
+    if (data_copy) {
+      memcpy(data_copy, cached->data, data_size);
+      out_logo->data = data_copy;
+      out_logo->width = cached->width;
+      out_logo->height = cached->height;
+      out_logo->valid = true;
+    }
+  }
+  xSemaphoreGive(cache_mutex);
+  if (out_logo->valid) {
+    return true;
+  }
+
+  // Try to load from SD card cache
+  if (load_sd_cached_logo(team_id, out_logo)) {
+    ESP_LOGI(TAG, "Loaded cached logo: %lu (%dx%d)", (unsigned long)team_id,
+             out_logo->width, out_logo->height);
+    mark_on_sd(team);
+    // Add to in-memory cache for faster subsequent loads
+    add_to_cache(team_id, out_logo->data, out_logo->width, out_logo->height);
+    return true;
+  }
+
+  // Not cached anywhere: download in the background, ahead of prefetches
+  request_download(team, info, NET_PRIO_LOGO_VISIBLE);
+  return false;
+}
+
+void logo_fetcher_prefetch(team_handle_t team) {
+  const team_info_t *info = team_registry_get(team);
+  if (!info || info->espn_id == 0 || is_on_sd(team)) {
+    return;
+  }
+
+  xSemaphoreTake(cache_mutex, portMAX_DELAY);
+  bool in_ram = find_cached_logo(info->espn_id) != NULL;
+  xSemaphoreGive(cache_mutex);
+  if (in_ram) {
+    return;
+  }
+
+  if (sd_available) {
+    char cache_path[64];
+    struct stat st;
+    build_cache_path(info->espn_id, cache_path, sizeof(cache_path));
+    if (stat(cache_path, &st) == 0) {
+      mark_on_sd(team);
+      return;
+    }
+  }
+
+  request_download(team, info, NET_PRIO_LOGO_PREFETCH);
+}
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "team_registry.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,12 +29,30 @@ typedef struct {
 void logo_fetcher_init(void);
 
 /**
- * @brief Fetch and decode a logo from URL (with in-memory caching)
- * @param url Logo URL
+ * @brief Called on the network task when a downloaded logo is ready
+ */
+typedef void (*logo_ready_cb_t)(team_handle_t team, void *ctx);
+
+/**
+ * @brief Set the callback run when a queued download completes
+ */
+void logo_fetcher_set_ready_cb(logo_ready_cb_t cb, void *ctx);
+
+/**
+ * @brief Get a team's logo from the RAM or SD cache
+ * @note On a miss the download is queued at visible priority and false is
+ * returned; the ready callback fires once it can be fetched again
+ * @param team Team handle from the team registry
  * @param out_logo Output logo data (caller must free data buffer when done)
  * @return true if successful, false otherwise
  */
-bool logo_fetcher_get(const char *url, logo_data_t *out_logo);
+bool logo_fetcher_get(team_handle_t team, logo_data_t *out_logo);
+
+/**
+ * @brief Queue a low-priority download if the logo is not cached yet
+ * @param team Team handle from the team registry
+ */
+void logo_fetcher_prefetch(team_handle_t team);
 
 #ifdef __cplusplus
 }
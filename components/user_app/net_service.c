@@ -0,0 +1,391 @@
+#include "net_service.h"
+#include "esp_crt_bundle.h"
+#include "esp_heap_caps.h"
+#include "esp_http_client.h"
+#include "esp_log.h"
+#include "esp_wifi_bsp.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "pm_bsp.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "NetService";
+
+#define NET_TASK_STACK 20480 // TLS handshake plus JSON/PNG work in callbacks
+#define NET_TASK_PRIORITY 5
+#define NET_WIFI_POLL_MS 1000
+#define NET_MAX_HOSTS 4
+#define NET_HOST_MAX_LEN 64
+
+// Minimum spacing between requests to the same host
+typedef struct {
+  const char *host;
+  uint32_t interval_ms;
+} net_host_limit_t;
+
+static const net_host_limit_t host_limits[] = {
+    {"site.api.espn.com", 10000},
+    {"a.espncdn.com", 250},
+};
+#define NET_DEFAULT_HOST_INTERVAL_MS 0
+
+typedef struct {
+  bool used;
+  net_priority_t priority;
+  uint32_t seq; // FIFO order within a priority
+  uint32_t key;
+  int max_body;
+  int timeout_ms;
+  net_done_cb_t on_done;
+  void *ctx;
+  char url[NET_URL_MAX_LEN];
+} net_job_t;
+
+typedef struct {
+  char host[NET_HOST_MAX_LEN];
+  TickType_t next_allowed;
+} net_host_state_t;
+
+static net_job_t *jobs = NULL; // NET_QUEUE_LEN slots in PSRAM
+static uint32_t next_seq = 0;
+static uint32_t active_keys[NET_MAX_SESSIONS];
+static net_host_state_t hosts[NET_MAX_HOSTS];
+static SemaphoreHandle_t jobs_mutex = NULL;
+static SemaphoreHandle_t work_sem[NET_MAX_SESSIONS];
+static bool paused = false; // No new jobs start while set
+static int in_flight = 0;
+
+// Copy the host part of a URL ("https://host:port/path" -> "host")
+static void url_host(const char *url, char *host, size_t max_len) {
+  const char *start = strstr(url, "://");
+  start = start ? start + 3 : url;
+  size_t len = strcspn(start, ":/?");
+  if (len >= max_len)
+    len = max_len - 1;
+  memcpy(host, start, len);
+  host[len] = '\0';
+}
+
+static uint32_t host_interval_ms(const char *host) {
+  for (size_t i = 0; i < sizeof(host_limits) / sizeof(host_limits[0]); i++) {
+    if (strcmp(host_limits[i].host, host) == 0)
+      return host_limits[i].interval_ms;
+  }
+  return NET_DEFAULT_HOST_INTERVAL_MS;
+}
+
+// Called with jobs_mutex held. Returns NULL if the table is full, in which
+// case the host is not rate limited.
+static net_host_state_t *host_state(const char *host) {
+  net_host_state_t *free_slot = NULL;
+  for (int i = 0; i < NET_MAX_HOSTS; i++) {
+    if (hosts[i].host[0] == '\0') {
+      if (!free_slot)
+        free_slot = &hosts[i];
+    } else if (strcmp(hosts[i].host, host) == 0) {
+      return &hosts[i];
+    }
+  }
+  if (free_slot) {
+    strncpy(free_slot->host, host, NET_HOST_MAX_LEN - 1);
+    free_slot->next_allowed = xTaskGetTickCount();
+  }
+  return free_slot;
+}
+
+// Sessions below NET_SCORES_SESSIONS are reserved for the scoreboard
+static net_priority_t session_lowest_priority(int session) {
+  return session < NET_SCORES_SESSIONS ? NET_PRIO_SCORES
+                                       : NET_PRIO_LOGO_PREFETCH;
+}
+
+// Each session sleeps on its own semaphore, so a reserved session can't
+// swallow the wake-up for a job only another session may run
+static void wake_sessions(int except) {
+  for (int i = 0; i < NET_MAX_SESSIONS; i++) {
+    if (i != except)
+      xSemaphoreGive(work_sem[i]);
+  }
+}
+
+// Pick the best runnable job up to the lowest priority: highest priority,
+// then oldest, skipping hosts that are still rate limited. Called with
+// jobs_mutex held. If nothing is runnable, *wait is set to the ticks until
+// the earliest throttled job.
+static net_job_t *pick_job(net_priority_t lowest, TickType_t *wait) {
+  TickType_t now = xTaskGetTickCount();
+  net_job_t *best = NULL;
+  *wait = portMAX_DELAY;
+
+  for (int i = 0; i < NET_QUEUE_LEN; i++) {
+    net_job_t *job = &jobs[i];
+    if (!job->used || job->priority > lowest)
+      continue;
+
+    char host[NET_HOST_MAX_LEN];
+    url_host(job->url, host, sizeof(host));
+    net_host_state_t *hs = host_state(host);
+    if (hs && (int32_t)(hs->next_allowed - now) > 0) {
+      TickType_t remaining = hs->next_allowed - now;
+      if (remaining < *wait)
+        *wait = remaining;
+      continue;
+    }
+
+    if (!best || job->priority < best->priority ||
+        (job->priority == best->priority &&
+         (int32_t)(job->seq - best->seq) < 0)) {
+      best = job;
+    }
+  }
+  return best;
+}
+
+// Run one GET. resp->body, when set, is freed by the caller.
+static void net_execute(const net_job_t *job, net_response_t *resp) {
+  memset(resp, 0, sizeof(*resp));
+
+  esp_http_client_config_t config = {
+      .url = job->url,
+      .timeout_ms = job->timeout_ms,
+      .crt_bundle_attach = esp_crt_bundle_attach,
+  };
+
+  esp_http_client_handle_t client = esp_http_client_init(&config);
+  if (!client) {
+    resp->err = ESP_ERR_NO_MEM;
+    return;
+  }
+
+  resp->err = esp_http_client_open(client, 0);
+  if (resp->err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to open %s: %s", job->url,
+             esp_err_to_name(resp->err));
+    esp_http_client_cleanup(client);
+    return;
+  }
+
+  int content_length = esp_http_client_fetch_headers(client);
+  resp->status = esp_http_client_get_status_code(client);
+  if (content_length > job->max_body) {
+    ESP_LOGW(TAG, "Response too large (%d bytes): %s", content_length,
+             job->url);
+    resp->err = ESP_ERR_INVALID_SIZE;
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    return;
+  }
+
+  // Chunked responses (content_length < 0) read up to max_body
+  resp->body = heap_caps_malloc(job->max_body + 1, MALLOC_CAP_SPIRAM);
+  if (!resp->body) {
+    ESP_LOGE(TAG, "Failed to allocate %d byte body", job->max_body);
+    resp->err = ESP_ERR_NO_MEM;
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    return;
+  }
+
+  while (resp->len < job->max_body) {
+    int read_len = esp_http_client_read(client, resp->body + resp->len,
+                                        job->max_body - resp->len);
+    if (read_len < 0) {
+      ESP_LOGE(TAG, "Read error: %s", job->url);
+      resp->err = ESP_FAIL;
+      break;
+    }
+    if (read_len == 0)
+      break;
+    resp->len += read_len;
+  }
+  resp->body[resp->len] = '\0';
+
+  if (resp->err == ESP_OK && resp->len >= job->max_body) {
+    ESP_LOGW(TAG, "Body truncated at %d bytes: %s", resp->len, job->url);
+  }
+
+  esp_http_client_close(client);
+  esp_http_client_cleanup(client);
+}
+
+static void net_worker_task(void *arg) {
+  int session = (int)(intptr_t)arg;
+
+  for (;;) {
+    // Hold everything while offline rather than failing requests
+    if (!espwifi_is_connected()) {
+      vTaskDelay(pdMS_TO_TICKS(NET_WIFI_POLL_MS));
+      continue;
+    }
+
+    TickType_t wait;
+    net_job_t job;
+    bool have_job = false;
+    bool more = false;
+
+    xSemaphoreTake(jobs_mutex, portMAX_DELAY);
+    net_job_t *picked = NULL;
+    wait = portMAX_DELAY;
+    if (!paused) {
+      picked = pick_job(session_lowest_priority(session), &wait);
+    }
+    if (picked) {
+      job = *picked;
+      picked->used = false;
+      have_job = true;
+      active_keys[session] = job.key;
+      in_flight++;
+
+      char host[NET_HOST_MAX_LEN];
+      url_host(job.url, host, sizeof(host));
+      net_host_state_t *hs = host_state(host);
+      if (hs) {
+        hs->next_allowed =
+            xTaskGetTickCount() + pdMS_TO_TICKS(host_interval_ms(host));
+      }
+
+      for (int i = 0; i < NET_QUEUE_LEN && !more; i++) {
+        more = jobs[i].used;
+      }
+    }
+    xSemaphoreGive(jobs_mutex);
+
+    if (!have_job) {
+      xSemaphoreTake(work_sem[session], wait);
+      continue;
+    }
+    if (more) {
+      // Let another session pick up the remaining work
+      wake_sessions(session);
+    }
+
+    net_response_t resp;
+    Pm_Acquire(PM_LOCK_NET);
+    net_execute(&job, &resp);
+    Pm_Release(PM_LOCK_NET);
+    if (job.on_done) {
+      job.on_done(&resp, job.ctx);
+    }
+    if (resp.body) {
+      free(resp.body);
+    }
+
+    xSemaphoreTake(jobs_mutex, portMAX_DELAY);
+    active_keys[session] = 0;
+    in_flight--;
+    xSemaphoreGive(jobs_mutex);
+  }
+}
+
+void net_service_init(void) {
+  if (jobs)
+    return;
+
+  jobs = heap_caps_calloc(NET_QUEUE_LEN, sizeof(net_job_t), MALLOC_CAP_SPIRAM);
+  jobs_mutex = xSemaphoreCreateMutex();
+  bool sems_ok = true;
+  for (int i = 0; i < NET_MAX_SESSIONS; i++) {
+    work_sem[i] = xSemaphoreCreateBinary();
+    sems_ok = sems_ok && work_sem[i];
+  }
+  if (!jobs || !jobs_mutex || !sems_ok) {
+    ESP_LOGE(TAG, "Failed to allocate request queue");
+    return;
+  }
+
+  for (int i = 0; i < NET_MAX_SESSIONS; i++) {
+    xTaskCreate(net_worker_task, "net_task", NET_TASK_STACK,
+                (void *)(intptr_t)i, NET_TASK_PRIORITY, NULL);
+  }
+  ESP_LOGI(TAG, "Network service started (%d sessions, %d for scores)",
+           NET_MAX_SESSIONS, NET_SCORES_SESSIONS);
+}
+
+bool net_service_submit(const net_request_t *req) {
+  if (!jobs || !req || !req->url)
+    return false;
+
+  if (strlen(req->url) >= NET_URL_MAX_LEN) {
+    ESP_LOGE(TAG, "URL too long: %s", req->url);
+    return false;
+  }
+
+  xSemaphoreTake(jobs_mutex, portMAX_DELAY);
+
+  if (req->key) {
+    // Already being fetched
+    for (int i = 0; i < NET_MAX_SESSIONS; i++) {
+      if (active_keys[i] == req->key) {
+        xSemaphoreGive(jobs_mutex);
+        return true;
+      }
+    }
+    // Already queued: promote it if this request is more urgent
+    for (int i = 0; i < NET_QUEUE_LEN; i++) {
+      if (jobs[i].used && jobs[i].key == req->key) {
+        if (req->priority < jobs[i].priority)
+          jobs[i].priority = req->priority;
+        xSemaphoreGive(jobs_mutex);
+        return true;
+      }
+    }
+  }
+
+  net_job_t *slot = NULL;
+  for (int i = 0; i < NET_QUEUE_LEN; i++) {
+    if (!jobs[i].used) {
+      slot = &jobs[i];
+      break;
+    }
+  }
+  if (!slot) {
+    xSemaphoreGive(jobs_mutex);
+    ESP_LOGW(TAG, "Request queue full, dropping %s", req->url);
+    return false;
+  }
+
+  slot->used = true;
+  slot->priority = req->priority;
+  slot->seq = next_seq++;
+  slot->key = req->key;
+  slot->max_body = req->max_body;
+  slot->timeout_ms = req->timeout_ms;
+  slot->on_done = req->on_done;
+  slot->ctx = req->ctx;
+  strcpy(slot->url, req->url);
+
+  xSemaphoreGive(jobs_mutex);
+  wake_sessions(-1);
+  return true;
+}
+
+bool net_service_pause(uint32_t timeout_ms) {
+  if (!jobs)
+    return true;
+
+  TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+  for (;;) {
+    xSemaphoreTake(jobs_mutex, portMAX_DELAY);
+    paused = true;
+    bool idle = in_flight == 0;
+    xSemaphoreGive(jobs_mutex);
+
+    if (idle)
+      return true;
+    if ((int32_t)(deadline - xTaskGetTickCount()) <= 0)
+      return false;
+    vTaskDelay(pdMS_TO_TICKS(50));
+  }
+}
+
+void net_service_resume(void) {
+  if (!jobs)
+    return;
+
+  xSemaphoreTake(jobs_mutex, portMAX_DELAY);
+  paused = false;
+  xSemaphoreGive(jobs_mutex);
+  wake_sessions(-1);
+}
@@ -0,0 +1,88 @@
+#ifndef NET_SERVICE_H
+#define NET_SERVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Concurrent HTTP(S) sessions; each TLS session costs tens of KB of internal
+// RAM, so this bounds the network stack's peak heap
+#define NET_MAX_SESSIONS 2
+
+// Sessions that only serve NET_PRIO_SCORES, so a slow logo download never
+// holds up a score refresh. An idle session holds no TLS state.
+#define NET_SCORES_SESSIONS 1
+
+// Pending requests across all priorities
+#define NET_QUEUE_LEN 32
+
+#define NET_URL_MAX_LEN 256
+
+// Lower value is served first
+typedef enum {
+  NET_PRIO_SCORES = 0,   // Scoreboard refresh
+  NET_PRIO_LOGO_VISIBLE, // Logo for a game on screen
+  NET_PRIO_LOGO_PREFETCH // Logo for a game that may rotate in later
+} net_priority_t;
+
+typedef struct {
+  esp_err_t err; // ESP_OK if the body was received
+  int status;    // HTTP status code, 0 if the connection failed
+  char *body;    // NUL-terminated, owned by the service
+  int len;
+} net_response_t;
+
+/**
+ * @brief Completion callback, run on the network task
+ * @note resp->body is freed when the callback returns
+ */
+typedef void (*net_done_cb_t)(const net_response_t *resp, void *ctx);
+
+typedef struct {
+  const char *url; // Copied on submit
+  net_priority_t priority;
+  uint32_t key;    // Non-zero: coalesce with a pending request of the same key
+  int max_body;    // Larger responses fail with ESP_ERR_INVALID_SIZE
+  int timeout_ms;
+  net_done_cb_t on_done;
+  void *ctx;
+} net_request_t;
+
+/**
+ * @brief Start the network worker task(s)
+ */
+void net_service_init(void);
+
+/**
+ * @brief Queue a GET request
+ * @note A request whose key matches a pending one is merged into it, taking
+ * the higher of the two priorities; the original callback is kept
+ * @param req Request description
+ * @return true if queued or merged, false if the queue is full
+ */
+bool net_service_submit(const net_request_t *req);
+
+/**
+ * @brief Stop starting queued requests and wait for running ones to finish
+ * @note Queued requests are kept; the service stays paused until
+ * net_service_resume()
+ * @param timeout_ms How long to wait for in-flight requests
+ * @return true if no request is running
+ */
+bool net_service_pause(uint32_t timeout_ms);
+
+/**
+ * @brief Undo net_service_pause()
+ */
+void net_service_resume(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NET_SERVICE_H
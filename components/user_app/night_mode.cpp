@@ -0,0 +1,260 @@
+#include "night_mode.h"
+#include "dashboard_screen.h"
+#include "esp_wifi_bsp.h"
+#include "lvgl_bsp.h"
+#include "net_service.h"
+#include "sensor_service.h"
+#include "seven_seg.h"
+#include "sntp_bsp.h"
+#include "sports_scores.h"
+#include "time_service.h"
+#include <driver/rtc_io.h>
+#include <esp_attr.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static const char *TAG = "NightMode";
+
+#define NIGHT_MAGIC 0x4E474854       // "NGHT"
+#define NIGHT_PARTITION "nightfb"    // Raw copy of the night frame
+#define NIGHT_WAKE_LATE_US 20000     // Wake just after the minute boundary
+#define NIGHT_STOP_TIMEOUT_MS 5000   // For running requests and sensor reads
+#define NIGHT_SCREEN_W 400
+#define NIGHT_SCREEN_H 300
+
+// Kept in RTC slow memory across deep sleep; zeroed by any other boot
+typedef struct {
+  uint32_t magic;
+  uint32_t frame_crc;
+  int32_t frame_len; // 0 if the frame could not be saved
+  time_t end;        // End of quiet hours, UTC
+  lv_area_t clock;   // Clock digits on screen
+  seven_seg_size_t clock_size;
+  uint32_t wakes;    // Clock repaints this night
+} night_state_t;
+
+static RTC_DATA_ATTR night_state_t night_state;
+static DisplayPort *panel = NULL;
+
+static int minute_of_day(int hour, int minute) { return hour * 60 + minute; }
+
+static bool in_quiet_hours(const struct tm *local) {
+  int now = minute_of_day(local->tm_hour, local->tm_min);
+  int start = minute_of_day(NIGHT_START_HOUR, NIGHT_START_MINUTE);
+  int end = minute_of_day(NIGHT_END_HOUR, NIGHT_END_MINUTE);
+  if (start <= end)
+    return now >= start && now < end;
+  return now >= start || now < end; // Spans midnight
+}
+
+// Next local NIGHT_END after now; mktime applies the DST rules
+static time_t quiet_end(time_t now) {
+  struct tm t;
+  localtime_r(&now, &t);
+  t.tm_hour = NIGHT_END_HOUR;
+  t.tm_min = NIGHT_END_MINUTE;
+  t.tm_sec = 0;
+  t.tm_isdst = -1;
+  time_t end = mktime(&t);
+  if (end <= now) {
+    localtime_r(&now, &t);
+    t.tm_mday += 1;
+    t.tm_hour = NIGHT_END_HOUR;
+    t.tm_min = NIGHT_END_MINUTE;
+    t.tm_sec = 0;
+    t.tm_isdst = -1;
+    end = mktime(&t);
+  }
+  return end;
+}
+
+static time_t next_wake(time_t now) {
+#if NIGHT_CLOCK_PERIOD_MIN > 0
+  if (night_state.frame_len > 0) {
+    time_t period = NIGHT_CLOCK_PERIOD_MIN * 60;
+    time_t next = (now / period + 1) * period;
+    if (next < night_state.end)
+      return next;
+  }
+#endif
+  return night_state.end;
+}
+
+static void sleep_until(time_t wake) {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  int64_t us = ((int64_t)wake - tv.tv_sec) * 1000000 - tv.tv_usec +
+               NIGHT_WAKE_LATE_US;
+  if (us < NIGHT_WAKE_LATE_US)
+    us = NIGHT_WAKE_LATE_US;
+
+  esp_sleep_enable_timer_wakeup((uint64_t)us);
+
+  // KEY pulls low; its pull-up needs the RTC peripherals powered
+  rtc_gpio_pullup_en((gpio_num_t)NIGHT_WAKE_KEY_GPIO);
+  rtc_gpio_pulldown_dis((gpio_num_t)NIGHT_WAKE_KEY_GPIO);
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);
+  esp_sleep_enable_ext1_wakeup_io(1ULL << NIGHT_WAKE_KEY_GPIO,
+                                  ESP_EXT1_WAKEUP_ANY_LOW);
+
+  panel->RLCD_PrepareDeepSleep();
+  esp_deep_sleep_start();
+}
+
+static bool save_frame(void) {
+  const esp_partition_t *part = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, NIGHT_PARTITION);
+  uint8_t *frame = panel->RLCD_GetBuffer();
+  int len = panel->RLCD_GetBufferLen();
+  if (!part || (size_t)len > part->size) {
+    ESP_LOGW(TAG, "No room for the night frame, clock will not update");
+    return false;
+  }
+
+  size_t erase_len = (len + part->erase_size - 1) / part->erase_size *
+                     part->erase_size;
+  if (esp_partition_erase_range(part, 0, erase_len) != ESP_OK ||
+      esp_partition_write(part, 0, frame, len) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to save the night frame");
+    return false;
+  }
+  night_state.frame_len = len;
+  night_state.frame_crc = esp_rom_crc32_le(0, frame, len);
+  return true;
+}
+
+static bool load_frame(void) {
+  const esp_partition_t *part = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, NIGHT_PARTITION);
+  uint8_t *frame = panel->RLCD_GetBuffer();
+  int len = night_state.frame_len;
+  if (!part || len != panel->RLCD_GetBufferLen() ||
+      esp_partition_read(part, 0, frame, len) != ESP_OK) {
+    return false;
+  }
+  return esp_rom_crc32_le(0, frame, len) == night_state.frame_crc;
+}
+
+static void clear_clock(void) {
+  const lv_area_t *a = &night_state.clock;
+  for (int y = a->y1; y <= a->y2; y++) {
+    for (int x = a->x1; x <= a->x2; x++) {
+      panel->RLCD_SetPixel(x, y, ColorWhite);
+    }
+  }
+}
+
+static void clock_px(int x, int y, void *ctx) {
+  const lv_area_t *a = &night_state.clock;
+  x += a->x1;
+  y += a->y1;
+  if (x <= a->x2 && y <= a->y2) {
+    panel->RLCD_SetPixel(x, y, ColorBlack);
+  }
+}
+
+bool night_mode_boot(DisplayPort *display) {
+  panel = display;
+  if (night_state.magic != NIGHT_MAGIC)
+    return false;
+  night_state.magic = 0; // Set again only if we go straight back to sleep
+
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  if (cause != ESP_SLEEP_WAKEUP_TIMER && cause != ESP_SLEEP_WAKEUP_EXT1)
+    return false;
+
+  // The controller kept running through deep sleep; no reset or init
+  panel->RLCD_Resume();
+  rtc_gpio_deinit((gpio_num_t)NIGHT_WAKE_KEY_GPIO);
+
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  if (cause == ESP_SLEEP_WAKEUP_TIMER && tv.tv_sec < night_state.end &&
+      load_frame()) {
+    // Fast path: no LVGL, WiFi or sensors, just the four digits. System
+    // time ran on the RTC timer through sleep.
+    setenv("TZ", SNTP_TIMEZONE, 1);
+    tzset();
+    struct tm local;
+    localtime_r(&tv.tv_sec, &local);
+
+    clear_clock();
+    seven_seg_paint(&night_state.clock_size, local.tm_hour, local.tm_min,
+                    true, clock_px, NULL);
+    panel->RLCD_Display();
+
+    night_state.magic = NIGHT_MAGIC;
+    night_state.wakes++;
+    sleep_until(next_wake(tv.tv_sec));
+  }
+
+  ESP_LOGI(TAG, "Night mode ended (%s) after %u clock updates",
+           cause == ESP_SLEEP_WAKEUP_EXT1 ? "key" : "timer",
+           (unsigned)night_state.wakes);
+  return true;
+}
+
+bool night_mode_due(const struct tm *local) {
+  if (!panel || !time_service_is_valid() || !in_quiet_hours(local))
+    return false;
+  if (esp_timer_get_time() < (int64_t)NIGHT_BOOT_AWAKE_MIN * 60 * 1000000)
+    return false;
+
+  game_info_t games[2];
+  int count = sports_scores_get_games(games, 2);
+  for (int i = 0; i < count; i++) {
+    if (games[i].is_live)
+      return false;
+  }
+  return true;
+}
+
+void night_mode_enter(void) {
+  // Let a running download or scores fetch finish (and its SD write land)
+  if (!net_service_pause(NIGHT_STOP_TIMEOUT_MS)) {
+    ESP_LOGW(TAG, "Network busy, retrying night mode later");
+    net_service_resume();
+    return;
+  }
+
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  time_t end = quiet_end(tv.tv_sec);
+  struct tm end_local;
+  localtime_r(&end, &end_local);
+
+  // Held until deep sleep so nothing redraws over the saved frame
+  Lvgl_lock(-1);
+  dashboard_show_night(end_local.tm_hour, end_local.tm_min);
+  dashboard_update_wifi(0, false);
+  lv_refr_now(NULL); // Renders and flushes into the panel synchronously
+
+  night_state = {};
+  night_state.end = end;
+  dashboard_get_clock_area(&night_state.clock);
+  night_state.clock_size = *dashboard_get_clock_size();
+  if (night_state.clock.x2 >= NIGHT_SCREEN_W)
+    night_state.clock.x2 = NIGHT_SCREEN_W - 1;
+  if (night_state.clock.y2 >= NIGHT_SCREEN_H)
+    night_state.clock.y2 = NIGHT_SCREEN_H - 1;
+
+  bool saved = NIGHT_CLOCK_PERIOD_MIN > 0 && save_frame();
+  if (!saved) {
+    // No clock wakes: don't leave a frozen time on screen all night
+    clear_clock();
+    panel->RLCD_Display();
+  }
+
+  sensor_service_stop(NIGHT_STOP_TIMEOUT_MS);
+  espwifi_stop();
+
+  night_state.magic = NIGHT_MAGIC;
+  ESP_LOGI(TAG, "Quiet hours until %02d:%02d, entering deep sleep",
+           end_local.tm_hour, end_local.tm_min);
+  sleep_until(next_wake(tv.tv_sec));
+}
@@ -0,0 +1,48 @@
+#ifndef NIGHT_MODE_H
+#define NIGHT_MODE_H
+
+#include "display_bsp.h"
+#include <stdbool.h>
+#include <time.h>
+
+// Quiet hours, local time. The dashboard renders a night frame, turns the
+// radio and sensors off and deep sleeps until NIGHT_END.
+#define NIGHT_START_HOUR 23
+#define NIGHT_START_MINUTE 0
+#define NIGHT_END_HOUR 6
+#define NIGHT_END_MINUTE 30
+
+// Deep-sleep wakes to repaint the clock digits (minutes); 0 sleeps straight
+// through and blanks the clock on the night frame
+#define NIGHT_CLOCK_PERIOD_MIN 1
+
+// Stay awake this long after any full boot (power-on, KEY press at night)
+#define NIGHT_BOOT_AWAKE_MIN 5
+
+// KEY button (active low, RTC-capable) wakes the dashboard early
+#define NIGHT_WAKE_KEY_GPIO 18
+
+/**
+ * @brief First call in app_main, before anything else touches the panel
+ * @note On a quiet-hours clock wake this restores the saved night frame,
+ * repaints the clock and goes back to deep sleep without returning.
+ * @param panel The RLCD port, kept for night_mode_enter()
+ * @return true if the panel still shows the night frame (skip RLCD_Init)
+ */
+bool night_mode_boot(DisplayPort *panel);
+
+/**
+ * @brief Check whether the dashboard should go to sleep now
+ * @param local Current local time
+ * @return true in quiet hours, with no live game and past the boot grace
+ */
+bool night_mode_due(const struct tm *local);
+
+/**
+ * @brief Render the night frame and enter deep sleep
+ * @note Takes the LVGL lock; call without it held. Returns only if the
+ * network could not be quiesced, in which case nothing was changed.
+ */
+void night_mode_enter(void);
+
+#endif // NIGHT_MODE_H
@@ -0,0 +1,252 @@
+#include "scores_parser.h"
+#include "cJSON.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "ScoresParser";
+
+// Intern a competitor's team (abbreviation, ESPN ID and logo path)
+static team_handle_t intern_team(cJSON *team, const char *fallback_abbrev) {
+  cJSON *abbrev = cJSON_GetObjectItem(team, "abbreviation");
+  cJSON *id = cJSON_GetObjectItem(team, "id");
+  cJSON *logo = cJSON_GetObjectItem(team, "logo");
+
+  return team_registry_intern(
+      cJSON_IsString(abbrev) ? abbrev->valuestring : fallback_abbrev,
+      cJSON_IsString(id) ? strtoul(id->valuestring, NULL, 10) : 0,
+      cJSON_IsString(logo) ? logo->valuestring : NULL);
+}
+
+// ID for an event the feed gave none. ESPN event IDs are decimal and well
+// below 2^31, so setting the top bit keeps these apart from real ones; the
+// hash of both teams keeps the ID stable when the feed reorders events.
+static uint32_t fallback_game_id(cJSON *home_team, cJSON *away_team) {
+  cJSON *teams[2] = {home_team, away_team};
+  uint32_t hash = 2166136261u; // FNV-1a
+  for (int t = 0; t < 2; t++) {
+    cJSON *id = cJSON_GetObjectItem(teams[t], "id");
+    cJSON *abbrev = cJSON_GetObjectItem(teams[t], "abbreviation");
+    const char *key = cJSON_IsString(id)       ? id->valuestring
+                      : cJSON_IsString(abbrev) ? abbrev->valuestring
+                                               : "";
+    for (const char *p = key; *p; p++) {
+      hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ '@') * 16777619u; // "A@B" differs from "AB@"
+  }
+  return hash | 0x80000000u;
+}
+
+// Filter/Prioritize logic
+// 1. If any live games, keep only live
+// 2. Else if any Final, keep only Final
+// 3. Else keep all (Scheduled)
+typedef enum { KEEP_ALL, KEEP_LIVE, KEEP_FINAL } keep_mode_t;
+
+static keep_mode_t filter_mode(const game_info_t *games, int count) {
+  bool any_final = false;
+  for (int i = 0; i < count; i++) {
+    if (games[i].is_live)
+      return KEEP_LIVE;
+    if (strstr(games[i].status, "Final"))
+      any_final = true;
+  }
+  return any_final ? KEEP_FINAL : KEEP_ALL;
+}
+
+static bool filter_keeps(keep_mode_t mode, const game_info_t *game) {
+  switch (mode) {
+  case KEEP_LIVE:
+    return game->is_live;
+  case KEEP_FINAL:
+    return strstr(game->status, "Final") != NULL;
+  default:
+    return true; // Show scheduled
+  }
+}
+
+int scores_parser_parse(const char *json_string, game_info_t *games,
+                        int max_games) {
+  if (max_games <= 0)
+    return 0;
+
+  // Team objects of each parsed game, interned once the filter has run
+  cJSON *(*team_refs)[2] = malloc(max_games * sizeof(*team_refs));
+  if (!team_refs) {
+    ESP_LOGE(TAG, "Out of memory");
+    return -1;
+  }
+
+  cJSON *root = cJSON_Parse(json_string);
+  if (root == NULL) {
+    const char *error_ptr = cJSON_GetErrorPtr();
+    if (error_ptr != NULL) {
+      ESP_LOGE(TAG, "Failed to parse JSON before: %s", error_ptr);
+    } else {
+      ESP_LOGE(TAG, "Failed to parse JSON (unknown error)");
+    }
+    free(team_refs);
+    return -1;
+  }
+
+  cJSON *events = cJSON_GetObjectItem(root, "events");
+  if (!cJSON_IsArray(events)) {
+    cJSON_Delete(root);
+    free(team_refs);
+    return -1;
+  }
+
+  int array_size = cJSON_GetArraySize(events);
+  int count = 0;
+
+  for (int i = 0; i < array_size && count < max_games; i++) {
+    cJSON *event = cJSON_GetArrayItem(events, i);
+    cJSON *event_id = cJSON_GetObjectItem(event, "id");
+    cJSON *competitions = cJSON_GetObjectItem(event, "competitions");
+    if (!cJSON_IsArray(competitions))
+      continue;
+    cJSON *competition = cJSON_GetArrayItem(competitions, 0);
+
+    cJSON *competitors = cJSON_GetObjectItem(competition, "competitors");
+    if (!cJSON_IsArray(competitors))
+      continue;
+
+    // Get status
+    cJSON *status_obj = cJSON_GetObjectItem(event, "status");
+    cJSON *type_obj = cJSON_GetObjectItem(status_obj, "type");
+    char status_str[32] = "N/A";
+    bool is_active = false;
+
+    if (type_obj) {
+      cJSON *state = cJSON_GetObjectItem(type_obj, "state");
+      if (cJSON_IsString(state) && strcmp(state->valuestring, "in") == 0) {
+        is_active = true;
+      }
+
+      // For scheduled games, extract just the time and convert to CST
+      if (cJSON_IsString(state) && strcmp(state->valuestring, "pre") == 0) {
+        cJSON *short_detail_item = cJSON_GetObjectItem(type_obj, "shortDetail");
+        if (cJSON_IsString(short_detail_item)) {
+          // Format is like "2/3 - 7:00 PM EST"
+          // Extract date and time, convert EST to CST (subtract 1 hour)
+          const char *detail = short_detail_item->valuestring;
+          const char *dash = strstr(detail, " - ");
+          if (dash) {
+            // Extract date portion (before " - ")
+            char date_part[8] = {0};
+            int date_len = dash - detail;
+            if (date_len > 0 && date_len < 8) {
+              strncpy(date_part, detail, date_len);
+            }
+
+            int hr = 0, min = 0;
+            char ampm[3] = {0};
+            if (sscanf(dash + 3, "%d:%d %2s", &hr, &min, ampm) == 3) {
+              // Convert EST to CST (subtract 1 hour)
+              hr--;
+              if (hr == 0)
+                hr = 12; // 1:00 PM EST -> 12:00 PM CST
+              else if (hr < 0) {
+                hr = 11;
+                ampm[0] = (ampm[0] == 'P') ? 'A' : 'P';
+              } // Midnight wrap
+              snprintf(status_str, sizeof(status_str), "%s %d:%02d%c",
+                       date_part, hr, min, ampm[0]);
+            } else {
+              strncpy(status_str, dash + 3, sizeof(status_str) - 1);
+            }
+          } else {
+            strncpy(status_str, short_detail_item->valuestring,
+                    sizeof(status_str) - 1);
+          }
+        }
+      } else {
+        // For live/final games, use shortDetail as-is (shows score or "Final")
+        cJSON *short_detail_item = cJSON_GetObjectItem(type_obj, "shortDetail");
+        if (cJSON_IsString(short_detail_item)) {
+          strncpy(status_str, short_detail_item->valuestring,
+                  sizeof(status_str) - 1);
+        }
+      }
+    }
+
+    // Competitors (usually Home is index 0, Away index 1 or vice versa based on
+    // homeAway) We just take first two
+    cJSON *comp1 = cJSON_GetArrayItem(competitors, 0);
+    cJSON *comp2 = cJSON_GetArrayItem(competitors, 1);
+
+    if (!comp1 || !comp2)
+      continue;
+
+    cJSON *team1 = cJSON_GetObjectItem(comp1, "team");
+    cJSON *team2 = cJSON_GetObjectItem(comp2, "team");
+
+    // Determine home/away
+    cJSON *homeAway1 = cJSON_GetObjectItem(comp1, "homeAway");
+    bool c1_is_home =
+        (homeAway1 && strcmp(homeAway1->valuestring, "home") == 0);
+
+    cJSON *home_comp = c1_is_home ? comp1 : comp2;
+    cJSON *away_comp = c1_is_home ? comp2 : comp1;
+    cJSON *home_team = c1_is_home ? team1 : team2;
+    cJSON *away_team = c1_is_home ? team2 : team1;
+
+    // Extract scores
+    int home_score_val = 0;
+    int away_score_val = 0;
+
+    cJSON *hs = cJSON_GetObjectItem(home_comp, "score");
+    if (cJSON_IsString(hs))
+      home_score_val = atoi(hs->valuestring);
+
+    cJSON *as = cJSON_GetObjectItem(away_comp, "score");
+    if (cJSON_IsString(as))
+      away_score_val = atoi(as->valuestring);
+
+    // Save to output
+    game_info_t *g = &games[count];
+    memset(g, 0, sizeof(*g));
+    g->id = cJSON_IsString(event_id) ? strtoul(event_id->valuestring, NULL, 10)
+                                     : fallback_game_id(home_team, away_team);
+    g->home_team = TEAM_HANDLE_NONE;
+    g->away_team = TEAM_HANDLE_NONE;
+    team_refs[count][0] = home_team;
+    team_refs[count][1] = away_team;
+    g->home_score = home_score_val;
+    g->away_score = away_score_val;
+    memcpy(g->status, status_str, sizeof(g->status) - 1); // g is zeroed above
+
+    g->is_live = is_active;
+    count++;
+  }
+
+  // The registry never forgets a team, so only intern the teams of games
+  // scores_parser_filter() will keep; the rest of the feed would slowly
+  // fill it
+  keep_mode_t mode = filter_mode(games, count);
+  for (int i = 0; i < count; i++) {
+    if (filter_keeps(mode, &games[i])) {
+      games[i].home_team = intern_team(team_refs[i][0], "HOME");
+      games[i].away_team = intern_team(team_refs[i][1], "AWAY");
+    }
+  }
+
+  cJSON_Delete(root);
+  free(team_refs);
+  return count;
+}
+
+int scores_parser_filter(game_info_t *games, int count) {
+  keep_mode_t mode = filter_mode(games, count);
+
+  // Filter in place, keeping order
+  int new_count = 0;
+  for (int i = 0; i < count; i++) {
+    if (filter_keeps(mode, &games[i])) {
+      games[new_count++] = games[i];
+    }
+  }
+  return new_count;
+}
@@ -0,0 +1,37 @@
+#ifndef SCORES_PARSER_H
+#define SCORES_PARSER_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "dashboard_screen.h"
+
+/**
+ * @brief Parse an ESPN scoreboard response into game records
+ * @note Teams are interned in the team registry as a side effect, only for
+ * the games scores_parser_filter() keeps; the others have no team handles
+ * @param json_string NUL-terminated scoreboard JSON
+ * @param games Output array
+ * @param max_games Capacity of games
+ * @return Number of games parsed, or -1 if the JSON is invalid
+ */
+int scores_parser_parse(const char *json_string, game_info_t *games,
+                        int max_games);
+
+/**
+ * @brief Keep only the games worth showing: live games if any are in
+ * progress, else finals if any, else everything scheduled
+ * @param games Games to filter in place (order is kept)
+ * @param count Number of games
+ * @return Number of games kept
+ */
+int scores_parser_filter(game_info_t *games, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCORES_PARSER_H
@@ -0,0 +1,379 @@
+#include "sensor_log.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *TAG = "SensorLog";
+
+#define LOG_RECORD_MAGIC 0x5345 // "SE"
+#define LOG_INDEX_MAGIC 0x534C4958
+#define LOG_INDEX_PATH SENSOR_LOG_DIR "/index.bin"
+#define RECORDS_PER_SECTOR (SENSOR_LOG_SECTOR / sizeof(sensor_log_record_t))
+
+_Static_assert(sizeof(sensor_log_record_t) == 16, "record must stay 16 bytes");
+_Static_assert(SENSOR_LOG_SEGMENT_RECORDS % RECORDS_PER_SECTOR == 0,
+               "segments must hold whole sectors");
+
+typedef struct {
+  uint32_t seq; // 0 = never written; highest is the active segment
+  uint32_t first_ts;
+  uint32_t last_ts;
+  uint32_t count;
+} log_segment_t;
+
+// Small index so replay can skip whole segments by time. It is written after
+// the data, so after a power cut it may lag the files; it is treated as a
+// hint and the active segment is always checked against its file.
+typedef struct {
+  uint32_t magic;
+  log_segment_t seg[SENSOR_LOG_SEGMENTS];
+  uint32_t crc;
+} log_index_t;
+
+static log_index_t index_data;
+static int active = 0;
+static bool log_ready = false;
+static SemaphoreHandle_t log_mutex = NULL;
+
+// Pending records; flushed when they reach the next sector boundary
+static sensor_log_record_t pending[RECORDS_PER_SECTOR];
+static int pending_count = 0;
+static sensor_log_record_t chunk[RECORDS_PER_SECTOR];
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  }
+  return crc;
+}
+
+static uint8_t record_crc(const sensor_log_record_t *rec) {
+  sensor_log_record_t tmp = *rec;
+  tmp.crc = 0;
+  return crc8((const uint8_t *)&tmp, sizeof(tmp));
+}
+
+static bool record_valid(const sensor_log_record_t *rec) {
+  return rec->magic == LOG_RECORD_MAGIC && rec->crc == record_crc(rec);
+}
+
+static uint32_t index_crc(const log_index_t *idx) {
+  // Two CRC-8s over halves are enough to catch a torn 72-byte write
+  size_t len = offsetof(log_index_t, crc);
+  return crc8((const uint8_t *)idx, len / 2) |
+         (crc8((const uint8_t *)idx + len / 2, len - len / 2) << 8);
+}
+
+static void segment_path(int seg, char *path, size_t len) {
+  snprintf(path, len, SENSOR_LOG_DIR "/seg%d.bin", seg);
+}
+
+static void write_index(void) {
+  index_data.magic = LOG_INDEX_MAGIC;
+  index_data.crc = index_crc(&index_data);
+  FILE *f = fopen(LOG_INDEX_PATH, "wb");
+  if (!f) {
+    ESP_LOGW(TAG, "Failed to write index");
+    return;
+  }
+  fwrite(&index_data, sizeof(index_data), 1, f);
+  fflush(f);
+  fsync(fileno(f));
+  fclose(f);
+}
+
+// Check a segment against its file: drop a torn or partially written tail
+// and refresh the count and time range. Returns false if the file is missing.
+static bool recover_segment(int seg) {
+  char path[48];
+  segment_path(seg, path, sizeof(path));
+  log_segment_t *s = &index_data.seg[seg];
+
+  struct stat st;
+  if (stat(path, &st) != 0) {
+    s->count = 0;
+    s->first_ts = 0;
+    s->last_ts = 0;
+    return false;
+  }
+
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+
+  uint32_t count = st.st_size / sizeof(sensor_log_record_t);
+  if (count > SENSOR_LOG_SEGMENT_RECORDS)
+    count = SENSOR_LOG_SEGMENT_RECORDS;
+
+  sensor_log_record_t rec;
+  while (count > 0) {
+    fseek(f, (count - 1) * sizeof(rec), SEEK_SET);
+    if (fread(&rec, sizeof(rec), 1, f) == 1 && record_valid(&rec))
+      break;
+    count--;
+  }
+  s->count = count;
+  s->last_ts = count ? rec.ts : 0;
+
+  s->first_ts = 0;
+  if (count) {
+    fseek(f, 0, SEEK_SET);
+    if (fread(&rec, sizeof(rec), 1, f) == 1 && record_valid(&rec))
+      s->first_ts = rec.ts;
+  }
+  fclose(f);
+
+  if ((off_t)(count * sizeof(rec)) != st.st_size) {
+    ESP_LOGW(TAG, "Segment %d: dropping torn tail (%ld -> %lu bytes)", seg,
+             (long)st.st_size, (unsigned long)(count * sizeof(rec)));
+    truncate(path, count * sizeof(rec));
+  }
+  return true;
+}
+
+static void rebuild_index(void) {
+  ESP_LOGW(TAG, "Index missing or damaged, rebuilding from segments");
+  memset(&index_data, 0, sizeof(index_data));
+
+  for (int i = 0; i < SENSOR_LOG_SEGMENTS; i++) {
+    recover_segment(i);
+  }
+
+  // Recreate the write order from each segment's first timestamp
+  for (uint32_t seq = 1; seq <= SENSOR_LOG_SEGMENTS; seq++) {
+    int oldest = -1;
+    for (int i = 0; i < SENSOR_LOG_SEGMENTS; i++) {
+      log_segment_t *s = &index_data.seg[i];
+      if (s->seq || !s->count)
+        continue;
+      if (oldest < 0 || s->first_ts < index_data.seg[oldest].first_ts)
+        oldest = i;
+    }
+    if (oldest < 0)
+      break;
+    index_data.seg[oldest].seq = seq;
+  }
+}
+
+static void find_active(void) {
+  active = 0;
+  for (int i = 1; i < SENSOR_LOG_SEGMENTS; i++) {
+    if (index_data.seg[i].seq > index_data.seg[active].seq)
+      active = i;
+  }
+}
+
+static void rotate(void) {
+  uint32_t seq = index_data.seg[active].seq;
+  active = (active + 1) % SENSOR_LOG_SEGMENTS;
+
+  char path[48];
+  segment_path(active, path, sizeof(path));
+  FILE *f = fopen(path, "wb");
+  if (f)
+    fclose(f);
+
+  log_segment_t *s = &index_data.seg[active];
+  memset(s, 0, sizeof(*s));
+  s->seq = seq + 1;
+  write_index();
+  ESP_LOGI(TAG, "Rotated to segment %d (seq %lu)", active,
+           (unsigned long)s->seq);
+}
+
+// Called with log_mutex held
+static void flush_locked(void) {
+  if (!pending_count)
+    return;
+
+  log_segment_t *s = &index_data.seg[active];
+  char path[48];
+  segment_path(active, path, sizeof(path));
+
+  FILE *f = fopen(path, "ab");
+  if (!f) {
+    ESP_LOGW(TAG, "Failed to open %s, dropping %d records", path,
+             pending_count);
+    pending_count = 0;
+    return;
+  }
+  size_t written = fwrite(pending, sizeof(pending[0]), pending_count, f);
+  fflush(f);
+  fsync(fileno(f));
+  fclose(f);
+
+  if (written > 0) {
+    if (s->count == 0)
+      s->first_ts = pending[0].ts;
+    s->last_ts = pending[written - 1].ts;
+    s->count += written;
+    write_index();
+  }
+  if (written != (size_t)pending_count) {
+    ESP_LOGW(TAG, "Short write (%d/%d records)", (int)written, pending_count);
+  }
+  pending_count = 0;
+}
+
+bool sensor_log_init(void) {
+  if (!log_mutex) {
+    log_mutex = xSemaphoreCreateMutex();
+  }
+
+  struct stat st;
+  if (stat("/sdcard", &st) != 0) {
+    ESP_LOGW(TAG, "SD card not available - sensor history will not persist");
+    return false;
+  }
+  if (stat(SENSOR_LOG_DIR, &st) != 0 && mkdir(SENSOR_LOG_DIR, 0755) != 0) {
+    ESP_LOGW(TAG, "Failed to create %s", SENSOR_LOG_DIR);
+    return false;
+  }
+
+  xSemaphoreTake(log_mutex, portMAX_DELAY);
+
+  bool index_ok = false;
+  FILE *f = fopen(LOG_INDEX_PATH, "rb");
+  if (f) {
+    index_ok = fread(&index_data, sizeof(index_data), 1, f) == 1 &&
+               index_data.magic == LOG_INDEX_MAGIC &&
+               index_data.crc == index_crc(&index_data);
+    fclose(f);
+  }
+
+  if (index_ok) {
+    find_active();
+    recover_segment(active);
+  } else {
+    rebuild_index();
+    find_active();
+  }
+  if (index_data.seg[active].seq == 0) {
+    index_data.seg[active].seq = 1;
+  }
+  write_index();
+
+  log_ready = true;
+  ESP_LOGI(TAG, "Sensor log ready: segment %d, %lu records", active,
+           (unsigned long)index_data.seg[active].count);
+  xSemaphoreGive(log_mutex);
+  return true;
+}
+
+void sensor_log_append(sensor_log_record_t *rec) {
+  if (!log_ready)
+    return;
+
+  rec->magic = LOG_RECORD_MAGIC;
+  rec->crc = record_crc(rec);
+
+  xSemaphoreTake(log_mutex, portMAX_DELAY);
+  if (index_data.seg[active].count >= SENSOR_LOG_SEGMENT_RECORDS) {
+    rotate();
+  }
+  pending[pending_count++] = *rec;
+
+  // Keep every write ending on a sector boundary of the file, even after an
+  // early sensor_log_flush() left the tail mid-sector
+  uint32_t to_boundary =
+      RECORDS_PER_SECTOR - index_data.seg[active].count % RECORDS_PER_SECTOR;
+  if ((uint32_t)pending_count >= to_boundary) {
+    flush_locked();
+  }
+  xSemaphoreGive(log_mutex);
+}
+
+void sensor_log_flush(void) {
+  if (!log_ready)
+    return;
+  xSemaphoreTake(log_mutex, portMAX_DELAY);
+  flush_locked();
+  xSemaphoreGive(log_mutex);
+}
+
+uint32_t sensor_log_newest(void) {
+  if (!log_ready)
+    return 0;
+  xSemaphoreTake(log_mutex, portMAX_DELAY);
+  uint32_t ts = pending_count ? pending[pending_count - 1].ts
+                              : index_data.seg[active].last_ts;
+  xSemaphoreGive(log_mutex);
+  return ts;
+}
+
+// First record index with ts >= from_ts; records are appended in time order
+static uint32_t seek_segment(FILE *f, uint32_t count, uint32_t from_ts) {
+  uint32_t lo = 0, hi = count;
+  sensor_log_record_t rec;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    fseek(f, mid * sizeof(rec), SEEK_SET);
+    if (fread(&rec, sizeof(rec), 1, f) != 1)
+      break;
+    if (rec.ts < from_ts)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+int sensor_log_replay(uint32_t from_ts, sensor_log_cb_t cb, void *ctx) {
+  if (!log_ready || !cb)
+    return 0;
+
+  xSemaphoreTake(log_mutex, portMAX_DELAY);
+  int visited = 0;
+
+  // Oldest segment first: the one after the active segment in ring order
+  for (int n = 1; n <= SENSOR_LOG_SEGMENTS; n++) {
+    int seg = (active + n) % SENSOR_LOG_SEGMENTS;
+    const log_segment_t *s = &index_data.seg[seg];
+    if (!s->seq || !s->count || s->last_ts < from_ts)
+      continue;
+
+    char path[48];
+    segment_path(seg, path, sizeof(path));
+    FILE *f = fopen(path, "rb");
+    if (!f)
+      continue;
+
+    uint32_t pos =
+        s->first_ts >= from_ts ? 0 : seek_segment(f, s->count, from_ts);
+    fseek(f, pos * sizeof(sensor_log_record_t), SEEK_SET);
+    while (pos < s->count) {
+      uint32_t want = s->count - pos;
+      if (want > RECORDS_PER_SECTOR)
+        want = RECORDS_PER_SECTOR;
+      size_t got = fread(chunk, sizeof(chunk[0]), want, f);
+      if (got == 0)
+        break;
+      for (size_t i = 0; i < got; i++) {
+        if (record_valid(&chunk[i]) && chunk[i].ts >= from_ts) {
+          cb(&chunk[i], ctx);
+          visited++;
+        }
+      }
+      pos += got;
+    }
+    fclose(f);
+  }
+
+  for (int i = 0; i < pending_count; i++) {
+    if (pending[i].ts >= from_ts) {
+      cb(&pending[i], ctx);
+      visited++;
+    }
+  }
+
+  xSemaphoreGive(log_mutex);
+  return visited;
+}
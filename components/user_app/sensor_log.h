@@ -0,0 +1,70 @@
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SENSOR_LOG_DIR "/sdcard/sensors"
+
+// Rotating segment files; the oldest is overwritten once all are full
+#define SENSOR_LOG_SEGMENTS 4
+#define SENSOR_LOG_SEGMENT_RECORDS 4096 // 64 KB, ~2.8 days at one per minute
+
+#define SENSOR_LOG_SECTOR 512
+
+#define SENSOR_LOG_CLIMATE 0x01
+#define SENSOR_LOG_BATTERY 0x02
+#define SENSOR_LOG_RSSI 0x04
+
+// One on-card record; 32 per sector
+typedef struct __attribute__((packed)) {
+  uint16_t magic;
+  uint8_t flags; // SENSOR_LOG_* fields present
+  uint8_t crc;   // CRC-8 over the rest of the record
+  uint32_t ts;   // Wall clock, seconds since the epoch
+  int16_t temp_c;    // Hundredths of a degree
+  uint16_t humidity; // Hundredths of a percent
+  uint8_t battery;   // Percent
+  int8_t rssi;       // dBm
+  uint16_t reserved;
+} sensor_log_record_t;
+
+typedef void (*sensor_log_cb_t)(const sensor_log_record_t *rec, void *ctx);
+
+/**
+ * @brief Open the log on the SD card, repairing a torn tail if needed
+ * @return true if the log is usable
+ */
+bool sensor_log_init(void);
+
+/**
+ * @brief Queue a record; written once a sector's worth is buffered
+ * @note rec->magic and rec->crc are filled in here
+ */
+void sensor_log_append(sensor_log_record_t *rec);
+
+/**
+ * @brief Write any buffered records now (e.g. before sleeping)
+ */
+void sensor_log_flush(void);
+
+/**
+ * @brief Timestamp of the newest record, 0 if the log is empty
+ */
+uint32_t sensor_log_newest(void);
+
+/**
+ * @brief Visit every stored record with ts >= from_ts, oldest first
+ * @return Number of records visited
+ */
+int sensor_log_replay(uint32_t from_ts, sensor_log_cb_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_LOG_H
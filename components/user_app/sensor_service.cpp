@@ -0,0 +1,334 @@
+#include "sensor_service.h"
+#include "adc_bsp.h"
+#include "boot_profile.h"
+#include "climate_history.h"
+#include "esp_wifi_bsp.h"
+#include "i2c_bsp.h"
+#include "i2c_equipment.h"
+#include "pm_bsp.h"
+#include "sensor_log.h"
+#include "time_service.h"
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+static const char *TAG = "SensorService";
+
+#define SENSOR_TASK_STACK (4 * 1024)
+#define SENSOR_TASK_PRIORITY 1 // Below the dashboard and LVGL tasks
+#define RTC_I2C_ADDR 0x51
+#define HISTORY_RESTORE_S (7 * 24 * 3600) // Depth of the coarsest ring
+#define MIN_VALID_EPOCH 1704067200        // 2024-01-01; earlier means unset
+
+// I2C bus and sensors
+static I2cMasterBus I2cbus(14, 13, 0);
+static Shtc3Port *shtc3port = NULL;
+
+// Seqlock: the acquisition task is the only writer. The sequence is odd
+// while a publish is in progress; readers retry until they see the same
+// even value before and after their copy.
+static sensor_snapshot_t snapshot;
+static TaskHandle_t sensor_task_handle = NULL;
+static volatile bool rtc_sync_requested = false;
+static volatile bool stop_requested = false;
+static SemaphoreHandle_t stopped_sem = NULL;
+static volatile uint32_t snapshot_seq = 0;
+#define SEQLOCK_SPIN_TRIES 8 // A publish is a struct copy; then sleep a tick
+
+static void publish(const sensor_snapshot_t *next) {
+  uint32_t seq = snapshot_seq;
+  __atomic_store_n(&snapshot_seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  snapshot = *next;
+  snapshot.version = (seq + 2) / 2;
+  __atomic_store_n(&snapshot_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+void sensor_service_log_bus_stats(void) {
+#if I2C_TRACE_ENABLE
+  I2cbus.i2c_trace_dump();
+#endif
+}
+
+void sensor_service_read(sensor_snapshot_t *out) {
+  for (int tries = 0;; tries++) {
+    uint32_t before = __atomic_load_n(&snapshot_seq, __ATOMIC_ACQUIRE);
+    if (!(before & 1)) {
+      *out = snapshot;
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      uint32_t after = __atomic_load_n(&snapshot_seq, __ATOMIC_RELAXED);
+      if (before == after)
+        return;
+    }
+    // The writer runs at a lower priority: if it was preempted mid-publish
+    // on this core, spinning (or taskYIELD) would never let it finish
+    if (tries >= SEQLOCK_SPIN_TRIES) {
+      vTaskDelay(1);
+    }
+  }
+}
+
+// History and the SD log are keyed by wall clock so they line up across
+// reboots; 0 until the clock has been set
+static uint32_t wall_clock_now(void) {
+  time_t now = time(NULL);
+  return now >= MIN_VALID_EPOCH ? (uint32_t)now : 0;
+}
+
+static void restore_record(const sensor_log_record_t *rec, void *ctx) {
+  if (rec->flags & SENSOR_LOG_CLIMATE) {
+    climate_history_add(HISTORY_TEMP_C, rec->temp_c / (float)HISTORY_SCALE,
+                        rec->ts);
+    climate_history_add(HISTORY_HUMIDITY,
+                        rec->humidity / (float)HISTORY_SCALE, rec->ts);
+  }
+  if (rec->flags & SENSOR_LOG_BATTERY) {
+    climate_history_add(HISTORY_BATTERY, rec->battery, rec->ts);
+  }
+}
+
+static void log_snapshot(const sensor_snapshot_t *snap, uint32_t ts) {
+  sensor_log_record_t rec = {};
+  rec.ts = ts;
+  if (snap->climate_valid) {
+    rec.flags |= SENSOR_LOG_CLIMATE;
+    rec.temp_c = (int16_t)(snap->temp_c * HISTORY_SCALE);
+    rec.humidity = (uint16_t)(snap->humidity * HISTORY_SCALE);
+  }
+  if (snap->battery_valid) {
+    rec.flags |= SENSOR_LOG_BATTERY;
+    rec.battery = snap->battery_percent;
+  }
+  if (snap->wifi_connected) {
+    rec.flags |= SENSOR_LOG_RSSI;
+    rec.rssi = snap->rssi;
+  }
+  sensor_log_append(&rec);
+}
+
+static void rtc_to_tm(const rtcTimeStruct_t *rtc, struct tm *out) {
+  memset(out, 0, sizeof(*out));
+  out->tm_year = rtc->year - 1900;
+  out->tm_mon = rtc->month - 1;
+  out->tm_mday = rtc->day;
+  out->tm_hour = rtc->hour;
+  out->tm_min = rtc->minute;
+  out->tm_sec = rtc->second;
+  out->tm_wday = rtc->week;
+}
+
+// Compare the RTC with freshly disciplined system time and, if the time
+// service asks for it, rewrite it on a second boundary
+static void sync_rtc(void) {
+  rtcTimeStruct_t rtc;
+  Rtc_GetTime(&rtc);
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+
+  struct tm rtc_tm;
+  rtc_to_tm(&rtc, &rtc_tm);
+  bool valid = rtc.year > 2000;
+  int32_t offset =
+      valid ? (int32_t)(time_service_utc_to_epoch(&rtc_tm) - tv.tv_sec) : 0;
+  if (!time_service_rtc_check(offset, valid))
+    return;
+
+  // Sleep past the next second boundary (rounded up to whole ticks, so
+  // never just short of it) and write the second actually reached
+  const uint32_t tick_us = portTICK_PERIOD_MS * 1000;
+  gettimeofday(&tv, NULL);
+  time_t target = tv.tv_sec + 1;
+  while (tv.tv_sec < target) {
+    uint32_t wait_us = 1000000 - tv.tv_usec;
+    vTaskDelay((wait_us + tick_us - 1) / tick_us);
+    gettimeofday(&tv, NULL);
+  }
+  struct tm utc;
+  gmtime_r(&tv.tv_sec, &utc);
+  Rtc_SetTime(utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday, utc.tm_hour,
+              utc.tm_min, utc.tm_sec);
+  ESP_LOGI(TAG, "RTC set from NTP (was %lds off)", (long)offset);
+}
+
+void sensor_service_request_rtc_sync(void) {
+  rtc_sync_requested = true;
+  if (sensor_task_handle) {
+    xTaskNotifyGive(sensor_task_handle);
+  }
+}
+
+static bool due(TickType_t now, TickType_t *next, uint32_t period_ms) {
+  if ((int32_t)(now - *next) < 0)
+    return false;
+  *next = now + pdMS_TO_TICKS(period_ms);
+  return true;
+}
+
+static TickType_t until(TickType_t now, TickType_t next, TickType_t wait) {
+  TickType_t remaining = (int32_t)(next - now) > 0 ? next - now : 0;
+  return remaining < wait ? remaining : wait;
+}
+
+// Slow bring-up, run on the acquisition task so it stays off the boot path:
+// the SHTC3 reset/ID sequence, the battery ADC and the SD log replay
+static void sensor_bringup(void) {
+  int span = boot_profile_begin("sensors");
+  Adc_PortInit();
+  shtc3port = new Shtc3Port(I2cbus);
+  boot_profile_end(span);
+
+  // Seed the in-RAM history from the SD log so trends show right away
+  uint32_t newest = sensor_log_newest();
+  if (newest) {
+    span = boot_profile_begin("history");
+    uint32_t from = newest > HISTORY_RESTORE_S ? newest - HISTORY_RESTORE_S : 0;
+    int restored = sensor_log_replay(from, restore_record, NULL);
+    boot_profile_end(span);
+    ESP_LOGI(TAG, "Restored %d logged samples", restored);
+  }
+
+  // Last bring-up stage
+  boot_profile_finish();
+}
+
+static void sensor_task(void *arg) {
+  sensor_bringup();
+
+  sensor_snapshot_t next = {};
+  TickType_t now = xTaskGetTickCount();
+  TickType_t next_climate = now;
+  TickType_t climate_read_at = now; // While a conversion is in flight
+  TickType_t next_battery = now;
+  TickType_t next_rssi = now;
+  TickType_t next_log = now + pdMS_TO_TICKS(SENSOR_LOG_PERIOD_MS);
+
+  for (;;) {
+    if (stop_requested) {
+      // Collect a conversion in flight; that also puts the sensor to sleep
+      if (shtc3port->Shtc3_IsMeasuring()) {
+        float rh, temp_c;
+        Pm_Acquire(PM_LOCK_I2C);
+        while (shtc3port->Shtc3_Poll(&temp_c, &rh) == NOT_READY) {
+          vTaskDelay(1);
+        }
+        Pm_Release(PM_LOCK_I2C);
+      }
+      sensor_log_flush();
+      xSemaphoreGive(stopped_sem);
+      vTaskSuspend(NULL);
+    }
+
+    bool changed = false;
+    // One wake-up covers all due reads; no light sleep mid-burst
+    Pm_Acquire(PM_LOCK_I2C);
+
+    if (rtc_sync_requested) {
+      rtc_sync_requested = false;
+      sync_rtc();
+    }
+    now = xTaskGetTickCount();
+
+    // Climate: wake the SHTC3 and start a conversion, sleep while it runs,
+    // then read it back on a later pass; the sensor sleeps in between
+    if (!shtc3port->Shtc3_IsMeasuring() &&
+        due(now, &next_climate, SENSOR_CLIMATE_PERIOD_MS)) {
+      if (shtc3port->Shtc3_StartMeasurement() == NO_ERROR) {
+        uint32_t meas_ms = (shtc3port->Shtc3_MeasTimeUs() + 999) / 1000;
+        climate_read_at = now + pdMS_TO_TICKS(meas_ms) + 1;
+      }
+    }
+
+    if (shtc3port->Shtc3_IsMeasuring() &&
+        (int32_t)(now - climate_read_at) >= 0) {
+      float rh, temp_c;
+      etError err = shtc3port->Shtc3_Poll(&temp_c, &rh);
+      if (err == NOT_READY) {
+        climate_read_at = now + 1;
+      } else if (err == NO_ERROR) {
+        next.climate_valid = true;
+        next.temp_c = temp_c;
+        next.humidity = rh;
+        changed = true;
+
+        uint32_t now_s = wall_clock_now();
+        if (now_s) {
+          climate_history_add(HISTORY_TEMP_C, temp_c, now_s);
+          climate_history_add(HISTORY_HUMIDITY, rh, now_s);
+        }
+      }
+    }
+
+    if (due(now, &next_battery, SENSOR_BATTERY_PERIOD_MS)) {
+      next.battery_valid = true;
+      next.battery_percent = Adc_GetBatteryLevel();
+      changed = true;
+
+      uint32_t now_s = wall_clock_now();
+      if (now_s) {
+        climate_history_add(HISTORY_BATTERY, next.battery_percent, now_s);
+      }
+    }
+
+    if (due(now, &next_rssi, SENSOR_RSSI_PERIOD_MS)) {
+      next.wifi_connected = espwifi_is_connected();
+      next.rssi = espwifi_get_rssi();
+      changed = true;
+    }
+
+    if (changed) {
+      publish(&next);
+    }
+
+    if (due(now, &next_log, SENSOR_LOG_PERIOD_MS)) {
+      uint32_t now_s = wall_clock_now();
+      if (now_s) {
+        log_snapshot(&next, now_s);
+      }
+    }
+
+    Pm_Release(PM_LOCK_I2C);
+
+    // Sleep until the next source is due
+    now = xTaskGetTickCount();
+    TickType_t wait = portMAX_DELAY;
+    wait = until(now, shtc3port->Shtc3_IsMeasuring() ? climate_read_at
+                                                      : next_climate,
+                 wait);
+    wait = until(now, next_battery, wait);
+    wait = until(now, next_rssi, wait);
+    wait = until(now, next_log, wait);
+    // Woken early by an RTC sync or stop request
+    ulTaskNotifyTake(pdTRUE, wait > 0 ? wait : 1);
+  }
+}
+
+void sensor_service_init(void) {
+  climate_history_init();
+
+  // Only the RTC is needed this early (it seeds the clock); the rest is
+  // brought up by the acquisition task
+  Rtc_Setup(&I2cbus, RTC_I2C_ADDR);
+}
+
+void sensor_service_start(void) {
+  xTaskCreate(sensor_task, "sensor_task", SENSOR_TASK_STACK, NULL,
+              SENSOR_TASK_PRIORITY, &sensor_task_handle);
+  ESP_LOGI(TAG, "Sensor acquisition started");
+}
+
+bool sensor_service_stop(uint32_t timeout_ms) {
+  if (!sensor_task_handle)
+    return true;
+  if (!stopped_sem) {
+    stopped_sem = xSemaphoreCreateBinary();
+    if (!stopped_sem)
+      return false;
+  }
+  stop_requested = true;
+  xTaskNotifyGive(sensor_task_handle);
+  return xSemaphoreTake(stopped_sem, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
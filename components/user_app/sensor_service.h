@@ -0,0 +1,73 @@
+#ifndef SENSOR_SERVICE_H
+#define SENSOR_SERVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Acquisition period per source
+#define SENSOR_CLIMATE_PERIOD_MS 5000
+#define SENSOR_BATTERY_PERIOD_MS 10000
+#define SENSOR_RSSI_PERIOD_MS 5000
+#define SENSOR_LOG_PERIOD_MS 60000 // One SD log record per minute
+
+typedef struct {
+  uint32_t version; // Bumped on every publish
+
+  bool climate_valid;
+  float temp_c;
+  float humidity;
+
+  bool battery_valid;
+  uint8_t battery_percent;
+
+  bool wifi_connected;
+  int8_t rssi;
+} sensor_snapshot_t;
+
+/**
+ * @brief Bring up the I2C bus and RTC (enough for time_service_init)
+ */
+void sensor_service_init(void);
+
+/**
+ * @brief Start the low-priority acquisition task, which first brings up the
+ * SHTC3 and battery ADC and replays the SD log into the history
+ * @note The SD card must be mounted (or known absent) by now
+ */
+void sensor_service_start(void);
+
+/**
+ * @brief Ask the acquisition task to check the RTC against system time and
+ * rewrite it if needed (after an NTP sync)
+ */
+void sensor_service_request_rtc_sync(void);
+
+/**
+ * @brief Stop acquisition before deep sleep: the SHTC3 is left in its sleep
+ * state and pending log records are flushed to the SD card
+ * @param timeout_ms How long to wait for the task to reach a safe point
+ * @return true once the task has stopped
+ */
+bool sensor_service_stop(uint32_t timeout_ms);
+
+/**
+ * @brief Copy the latest readings without blocking on any hardware
+ * @param out Snapshot to fill
+ */
+void sensor_service_read(sensor_snapshot_t *out);
+
+/**
+ * @brief Log the I2C bus trace (per-device latency and errors, recent
+ * transactions); does nothing unless I2C_TRACE_ENABLE is set in i2c_bsp.h
+ */
+void sensor_service_log_bus_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_SERVICE_H
@@ -18,4 +18,8 @@
 // MLB American League East: TBD, National League East: TBD
 #define LEAGUE_GROUP "23"
 
+// Fetch from this URL instead of ESPN, e.g. the fixture stand-in server in
+// tools/scores_replay: "http://192.168.1.50:8080/scoreboard"
+// #define SCORES_API_URL_OVERRIDE "http://192.168.1.50:8080/scoreboard"
+
 #endif // SPORTS_CONFIG_H
@@ -1,324 +1,369 @@
 #include "sports_scores.h"
-#include "cJSON.h"
-#include "esp_crt_bundle.h"
-#include "esp_http_client.h"
 #include "esp_log.h"
 #include "esp_wifi_bsp.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
-#include "sntp_bsp.h"
+#include "freertos/timers.h"
+#include "logo_fetcher.h"
+#include "net_service.h"
+#include "nvs.h"
+#include "time_service.h"
+#include "scores_parser.h"
 #include "sports_config.h"
+#include "team_registry.h"
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 static const char *TAG = "SportsScores";
 
 #define MAX_GAMES 20
 #define REFRESH_INTERVAL_MS 60000
+#define ROTATE_INTERVAL_MS 15000
+#define SCORE_EVENT_QUEUE_LEN 32
+#define NOT_READY_RETRY_MS 5000
+#define TIMER_CMD_BLOCK_MS 100 // Timer command queue wait, off the timer task
+#define SCORES_MAX_BODY (192 * 1024) // Response buffer in PSRAM
+
+// Warm-start snapshot persisted to NVS after each successful parse
+#define SNAPSHOT_NAMESPACE "scores"
+#define SNAPSHOT_KEY "snapshot"
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_MIN_WRITE_INTERVAL_MS (15 * 60 * 1000) // Protect flash
+#define SNAPSHOT_MAX_TEAMS (2 * MAX_GAMES)
+
+// Blob layout: header, team_info_t[team_count], game_info_t[count]. Team
+// handles in the stored games index the stored team table, since registry
+// handles are only valid for one boot.
+typedef struct {
+  uint16_t version;
+  uint8_t count;
+  uint8_t team_count;
+  uint32_t hash;      // FNV-1a over the teams and games that follow
+  int64_t fetched_at; // UNIX time of the fetch
+} scores_snapshot_t;
 
 static game_info_t games_cache[MAX_GAMES];
 static int games_count = 0;
 static SemaphoreHandle_t games_mutex = NULL;
 
-static void parse_scores_json(const char *json_string) {
-  cJSON *root = cJSON_Parse(json_string);
-  if (root == NULL) {
-    const char *error_ptr = cJSON_GetErrorPtr();
-    if (error_ptr != NULL) {
-      ESP_LOGE(TAG, "Failed to parse JSON before: %s", error_ptr);
-    } else {
-      ESP_LOGE(TAG, "Failed to parse JSON (unknown error)");
-    }
+// Delta events for the dashboard (see score_event_type_t)
+static QueueHandle_t score_event_queue = NULL;
+static TimerHandle_t rotate_timer = NULL;
+static TimerHandle_t refresh_timer = NULL;
+static volatile uint32_t refresh_rearm_ms = 0; // Non-zero: re-arm failed
+static char scores_url[NET_URL_MAX_LEN];
+static volatile uint32_t rotation_base = 0;
+
+// True while games_cache holds the NVS snapshot rather than a live fetch
+static bool snapshot_stale = false;
+static time_t snapshot_fetched_at = 0;
+// Content on flash, known after a save or a restore
+static uint32_t last_saved_hash = 0;
+static bool last_saved_hash_valid = false;
+// Rate limit; only a write from this boot starts it
+static TickType_t last_saved_tick = 0;
+static bool snapshot_saved_once = false;
+
+static void post_score_event(score_event_type_t type, uint32_t game_id) {
+  if (!score_event_queue)
     return;
+  score_event_t ev = {.type = type, .game_id = game_id};
+  if (xQueueSend(score_event_queue, &ev, 0) != pdTRUE) {
+    ESP_LOGW(TAG, "Score event queue full, dropping event %d", type);
   }
+}
 
-  cJSON *events = cJSON_GetObjectItem(root, "events");
-  if (!cJSON_IsArray(events)) {
-    cJSON_Delete(root);
-    return;
+static const game_info_t *find_game(const game_info_t *games, int count,
+                                    uint32_t id) {
+  for (int i = 0; i < count; i++) {
+    if (games[i].id == id)
+      return &games[i];
   }
+  return NULL;
+}
 
-  int array_size = cJSON_GetArraySize(events);
-  game_info_t temp_games[MAX_GAMES];
-  int temp_count = 0;
-
-  for (int i = 0; i < array_size && temp_count < MAX_GAMES; i++) {
-    cJSON *event = cJSON_GetArrayItem(events, i);
-    cJSON *competitions = cJSON_GetObjectItem(event, "competitions");
-    if (!cJSON_IsArray(competitions))
-      continue;
-    cJSON *competition = cJSON_GetArrayItem(competitions, 0);
-
-    cJSON *competitors = cJSON_GetObjectItem(competition, "competitors");
-    if (!cJSON_IsArray(competitors))
+// Compare the previous snapshot against the new one and collect the deltas.
+// Called with games_mutex held; events are posted after it is released.
+static int diff_games(const game_info_t *old_games, int old_count,
+                      const game_info_t *new_games, int new_count,
+                      score_event_t *events, int max_events) {
+  int n = 0;
+
+  for (int i = 0; i < new_count && n < max_events; i++) {
+    const game_info_t *g = &new_games[i];
+    const game_info_t *prev = find_game(old_games, old_count, g->id);
+    if (!prev) {
+      events[n++] = (score_event_t){SCORE_EVENT_GAME_ADDED, g->id};
       continue;
+    }
+    if (prev->away_score != g->away_score ||
+        prev->home_score != g->home_score) {
+      events[n++] = (score_event_t){SCORE_EVENT_SCORE_CHANGED, g->id};
+    }
+    if (n < max_events &&
+        (prev->is_live != g->is_live || strcmp(prev->status, g->status) != 0)) {
+      events[n++] = (score_event_t){SCORE_EVENT_STATUS_CHANGED, g->id};
+    }
+  }
 
-    // Get status
-    cJSON *status_obj = cJSON_GetObjectItem(event, "status");
-    cJSON *type_obj = cJSON_GetObjectItem(status_obj, "type");
-    char status_str[32] = "N/A";
-    bool is_active = false;
-
-    if (type_obj) {
-      cJSON *state = cJSON_GetObjectItem(type_obj, "state");
-      if (cJSON_IsString(state) && strcmp(state->valuestring, "in") == 0) {
-        is_active = true;
-      }
-
-      // For scheduled games, extract just the time and convert to CST
-      if (cJSON_IsString(state) && strcmp(state->valuestring, "pre") == 0) {
-        cJSON *short_detail_item = cJSON_GetObjectItem(type_obj, "shortDetail");
-        if (cJSON_IsString(short_detail_item)) {
-          // Format is like "2/3 - 7:00 PM EST"
-          // Extract date and time, convert EST to CST (subtract 1 hour)
-          const char *detail = short_detail_item->valuestring;
-          const char *dash = strstr(detail, " - ");
-          if (dash) {
-            // Extract date portion (before " - ")
-            char date_part[8] = {0};
-            int date_len = dash - detail;
-            if (date_len > 0 && date_len < 8) {
-              strncpy(date_part, detail, date_len);
-            }
-
-            int hr = 0, min = 0;
-            char ampm[3] = {0};
-            if (sscanf(dash + 3, "%d:%d %2s", &hr, &min, ampm) == 3) {
-              // Convert EST to CST (subtract 1 hour)
-              hr--;
-              if (hr == 0)
-                hr = 12; // 1:00 PM EST -> 12:00 PM CST
-              else if (hr < 0) {
-                hr = 11;
-                ampm[0] = (ampm[0] == 'P') ? 'A' : 'P';
-              } // Midnight wrap
-              snprintf(status_str, sizeof(status_str), "%s %d:%02d%c",
-                       date_part, hr, min, ampm[0]);
-            } else {
-              strncpy(status_str, dash + 3, sizeof(status_str) - 1);
-            }
-          } else {
-            strncpy(status_str, short_detail_item->valuestring,
-                    sizeof(status_str) - 1);
-          }
-        }
-      } else {
-        // For live/final games, use shortDetail as-is (shows score or "Final")
-        cJSON *short_detail_item = cJSON_GetObjectItem(type_obj, "shortDetail");
-        if (cJSON_IsString(short_detail_item)) {
-          strncpy(status_str, short_detail_item->valuestring,
-                  sizeof(status_str) - 1);
-        }
-      }
+  for (int i = 0; i < old_count && n < max_events; i++) {
+    if (!find_game(new_games, new_count, old_games[i].id)) {
+      events[n++] = (score_event_t){SCORE_EVENT_GAME_REMOVED, old_games[i].id};
     }
+  }
 
-    // Competitors (usually Home is index 0, Away index 1 or vice versa based on
-    // homeAway) We just take first two
-    cJSON *comp1 = cJSON_GetArrayItem(competitors, 0);
-    cJSON *comp2 = cJSON_GetArrayItem(competitors, 1);
+  return n;
+}
 
-    if (!comp1 || !comp2)
-      continue;
+static uint32_t hash_bytes(const void *data, size_t len) {
+  // FNV-1a; records are zero-filled so padding is stable
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
+}
 
-    cJSON *team1 = cJSON_GetObjectItem(comp1, "team");
-    cJSON *team2 = cJSON_GetObjectItem(comp2, "team");
-
-    // Determine home/away
-    cJSON *homeAway1 = cJSON_GetObjectItem(comp1, "homeAway");
-    bool c1_is_home =
-        (homeAway1 && strcmp(homeAway1->valuestring, "home") == 0);
-
-    cJSON *home_comp = c1_is_home ? comp1 : comp2;
-    cJSON *away_comp = c1_is_home ? comp2 : comp1;
-    cJSON *home_team = c1_is_home ? team1 : team2;
-    cJSON *away_team = c1_is_home ? team2 : team1;
-
-    // Extract names and scores
-    char home_abbrev[8] = "HOME";
-    char away_abbrev[8] = "AWAY";
-    int home_score_val = 0;
-    int away_score_val = 0;
-
-    cJSON *ha = cJSON_GetObjectItem(home_team, "abbreviation");
-    if (cJSON_IsString(ha))
-      strncpy(home_abbrev, ha->valuestring, 7);
-
-    cJSON *aa = cJSON_GetObjectItem(away_team, "abbreviation");
-    if (cJSON_IsString(aa))
-      strncpy(away_abbrev, aa->valuestring, 7);
-
-    cJSON *hs = cJSON_GetObjectItem(home_comp, "score");
-    if (cJSON_IsString(hs))
-      home_score_val = atoi(hs->valuestring);
-
-    cJSON *as = cJSON_GetObjectItem(away_comp, "score");
-    if (cJSON_IsString(as))
-      away_score_val = atoi(as->valuestring);
-
-    // Save to temp
-    game_info_t *g = &temp_games[temp_count];
-    strncpy(g->home_abbrev, home_abbrev, 7);
-    strncpy(g->away_abbrev, away_abbrev, 7);
-    g->home_score = home_score_val;
-    g->away_score = away_score_val;
-    strncpy(g->status, status_str, 31);
-
-    // Extract logos
-    cJSON *home_logo = cJSON_GetObjectItem(home_team, "logo");
-    if (cJSON_IsString(home_logo)) {
-      strncpy(g->home_logo_url, home_logo->valuestring,
-              sizeof(g->home_logo_url) - 1);
-    } else {
-      g->home_logo_url[0] = 0;
-    }
+// Map a registry handle to its index in the snapshot's team table
+static team_handle_t snapshot_team(team_info_t *teams, int *team_count,
+                                   team_handle_t handle) {
+  const team_info_t *info = team_registry_get(handle);
+  if (!info)
+    return TEAM_HANDLE_NONE;
+  for (int i = 0; i < *team_count; i++) {
+    if (memcmp(&teams[i], info, sizeof(team_info_t)) == 0)
+      return i;
+  }
+  if (*team_count >= SNAPSHOT_MAX_TEAMS)
+    return TEAM_HANDLE_NONE;
+  teams[*team_count] = *info;
+  return (*team_count)++;
+}
 
-    cJSON *away_logo = cJSON_GetObjectItem(away_team, "logo");
-    if (cJSON_IsString(away_logo)) {
-      strncpy(g->away_logo_url, away_logo->valuestring,
-              sizeof(g->away_logo_url) - 1);
-    } else {
-      g->away_logo_url[0] = 0;
-    }
+static void save_snapshot(const game_info_t *games, int count) {
+  size_t max_size = sizeof(scores_snapshot_t) +
+                    SNAPSHOT_MAX_TEAMS * sizeof(team_info_t) +
+                    MAX_GAMES * sizeof(game_info_t);
+  scores_snapshot_t *snap = calloc(1, max_size);
+  if (!snap)
+    return;
 
-    g->is_live = is_active;
-    temp_count++;
+  // Serialize first; the hash covers the portable (re-indexed) form
+  team_info_t *teams = (team_info_t *)(snap + 1);
+  game_info_t stored[MAX_GAMES];
+  int team_count = 0;
+  for (int i = 0; i < count; i++) {
+    stored[i] = games[i];
+    stored[i].away_team = snapshot_team(teams, &team_count, games[i].away_team);
+    stored[i].home_team = snapshot_team(teams, &team_count, games[i].home_team);
+  }
+  memcpy(teams + team_count, stored, count * sizeof(game_info_t));
+  size_t payload =
+      team_count * sizeof(team_info_t) + count * sizeof(game_info_t);
+  size_t size = sizeof(scores_snapshot_t) + payload;
+  uint32_t hash = hash_bytes(teams, payload);
+  TickType_t now = xTaskGetTickCount();
+
+  // Skip unchanged content, and rate-limit changed content
+  if ((last_saved_hash_valid && hash == last_saved_hash) ||
+      (snapshot_saved_once &&
+       (now - last_saved_tick) < pdMS_TO_TICKS(SNAPSHOT_MIN_WRITE_INTERVAL_MS))) {
+    free(snap);
+    return;
   }
-  cJSON_Delete(root);
 
-  // Filter/Prioritize logic
-  // 1. If any live games, keep only live
-  // 2. Else if any Final, keep only Final
-  // 3. Else keep all (Scheduled)
+  snap->version = SNAPSHOT_VERSION;
+  snap->count = count;
+  snap->team_count = team_count;
+  snap->hash = hash;
+  snap->fetched_at = (int64_t)time(NULL);
+
+  nvs_handle_t nvs;
+  esp_err_t err = nvs_open(SNAPSHOT_NAMESPACE, NVS_READWRITE, &nvs);
+  if (err == ESP_OK) {
+    err = nvs_set_blob(nvs, SNAPSHOT_KEY, snap, size);
+    if (err == ESP_OK)
+      err = nvs_commit(nvs);
+    nvs_close(nvs);
+  }
+  free(snap);
+
+  if (err == ESP_OK) {
+    last_saved_hash = hash;
+    last_saved_hash_valid = true;
+    last_saved_tick = now;
+    snapshot_saved_once = true;
+    ESP_LOGI(TAG, "Saved scoreboard snapshot (%d games, %d bytes)", count,
+             (int)size);
+  } else {
+    ESP_LOGW(TAG, "Failed to save snapshot: %s", esp_err_to_name(err));
+  }
+}
 
-  bool any_live = false;
-  bool any_final = false;
+static void scores_lazy_init(void) {
+  if (!games_mutex) {
+    games_mutex = xSemaphoreCreateMutex();
+  }
+  if (!score_event_queue) {
+    score_event_queue =
+        xQueueCreate(SCORE_EVENT_QUEUE_LEN, sizeof(score_event_t));
+  }
+}
+
+static void schedule_refresh(uint32_t delay_ms);
 
-  for (int i = 0; i < temp_count; i++) {
-    if (temp_games[i].is_live)
-      any_live = true;
-    if (strstr(temp_games[i].status, "Final"))
-      any_final = true;
+static void rotate_timer_cb(TimerHandle_t timer) {
+  if (refresh_rearm_ms) {
+    schedule_refresh(refresh_rearm_ms);
   }
 
-  if (games_mutex) {
-    xSemaphoreTake(games_mutex, portMAX_DELAY);
-    games_count = 0;
-    for (int i = 0; i < temp_count; i++) {
-      bool include = false;
-      if (any_live) {
-        if (temp_games[i].is_live)
-          include = true;
-      } else if (any_final) {
-        if (strstr(temp_games[i].status, "Final"))
-          include = true;
-      } else {
-        include = true; // Show scheduled
-      }
-
-      if (include && games_count < MAX_GAMES) {
-        games_cache[games_count++] = temp_games[i];
-      }
-    }
-    xSemaphoreGive(games_mutex);
+  // Runs on the timer service task: never block it on the parser, just
+  // skip this rotation if the cache is being replaced
+  if (!games_mutex || xSemaphoreTake(games_mutex, pdMS_TO_TICKS(10)) != pdTRUE)
+    return;
+  int count = games_count;
+  xSemaphoreGive(games_mutex);
+
+  // With a single game there is nothing to rotate
+  if (count > 1) {
+    rotation_base++;
+    post_score_event(SCORE_EVENT_ROTATE, 0);
   }
 }
 
-static void http_test_task(void *pvParameters) {
-  char *response_buffer = NULL;
-  int response_len = 0;
-  int buffer_cap = 0;
+static void parse_scores_json(const char *json_string) {
+  game_info_t temp_games[MAX_GAMES];
+  int temp_count = scores_parser_parse(json_string, temp_games, MAX_GAMES);
+  if (temp_count < 0)
+    return;
 
-  // Build ESPN API URLdynamically from configuration
-  char espn_api_url[256];
-  snprintf(espn_api_url, sizeof(espn_api_url),
-           "https://site.api.espn.com/apis/site/v2/sports/%s/%s/"
-           "scoreboard?groups=%s&limit=20",
-           SPORT_TYPE, LEAGUE_TYPE, LEAGUE_GROUP);
+  int new_count = scores_parser_filter(temp_games, temp_count);
 
-  esp_http_client_config_t config = {
-      .url = espn_api_url,
-      .event_handler = NULL,
-      .timeout_ms = 10000,
-      .crt_bundle_attach = esp_crt_bundle_attach,
-  };
+  if (games_mutex) {
+    score_event_t events[SCORE_EVENT_QUEUE_LEN];
+    int event_count = 0;
 
-  while (1) {
-    // Wait for WiFi and SNTP sync before fetching
-    if (!espwifi_is_connected() || !sntp_time_is_synced()) {
-      vTaskDelay(pdMS_TO_TICKS(5000));
-      continue;
+    xSemaphoreTake(games_mutex, portMAX_DELAY);
+    event_count = diff_games(games_cache, games_count, temp_games, new_count,
+                             events, SCORE_EVENT_QUEUE_LEN);
+    memcpy(games_cache, temp_games, new_count * sizeof(game_info_t));
+    games_count = new_count;
+    bool was_stale = snapshot_stale;
+    snapshot_stale = false;
+    xSemaphoreGive(games_mutex);
+
+    for (int i = 0; i < event_count; i++) {
+      post_score_event(events[i].type, events[i].game_id);
+    }
+    // Replaces the warm-start snapshot even if nothing differed
+    if (was_stale) {
+      post_score_event(SCORE_EVENT_LIVE, 0);
     }
 
-    ESP_LOGI(TAG, "Fetching scores...");
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    esp_err_t err = esp_http_client_open(client, 0);
-
-    if (err == ESP_OK) {
-      int content_length = esp_http_client_fetch_headers(client);
-      if (content_length < 0) {
-        // Chunked encoding
-        content_length = 32 * 1024; // Default guess
-      }
-
-      // Alloc buffer in PSRAM
-      if (!response_buffer) {
-        buffer_cap = 192 * 1024; // Use 192KB in PSRAM to be absolutely sure
-        response_buffer = heap_caps_malloc(buffer_cap + 1, MALLOC_CAP_SPIRAM);
-      }
-      response_len = 0;
-
-      if (response_buffer) {
-        int read_len;
-        while (1) {
-          read_len =
-              esp_http_client_read(client, response_buffer + response_len,
-                                   buffer_cap - response_len);
-          if (read_len <= 0) {
-            if (read_len < 0)
-              ESP_LOGE(TAG, "Read error");
-            break;
-          }
-          response_len += read_len;
-
-          if (response_len >= buffer_cap) {
-            ESP_LOGW(TAG, "Buffer full, truncating...");
-            break;
-          }
-        }
-        response_buffer[response_len] = 0; // Null terminate
-        ESP_LOGI(TAG, "Read %d bytes", response_len);
-
-        // Parse loaded JSON
-        parse_scores_json(response_buffer);
-      }
-    } else {
-      ESP_LOGE(TAG, "HTTP connection failed: %d", err);
+    save_snapshot(temp_games, new_count);
+
+    // Queue logos for games that will rotate in later
+    for (int i = 0; i < new_count; i++) {
+      logo_fetcher_prefetch(temp_games[i].away_team);
+      logo_fetcher_prefetch(temp_games[i].home_team);
+    }
+    if (event_count > 0) {
+      ESP_LOGI(TAG, "%d games, %d score events", new_count, event_count);
     }
+  }
+}
 
-    esp_http_client_cleanup(client);
-    vTaskDelay(pdMS_TO_TICKS(REFRESH_INTERVAL_MS));
+// The refresh timer is one-shot: a lost re-arm would stop refreshes for
+// good, so a failure is retried from the rotation timer
+static void schedule_refresh(uint32_t delay_ms) {
+  // The timer task can't wait on its own command queue
+  TickType_t block =
+      xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()
+          ? 0
+          : pdMS_TO_TICKS(TIMER_CMD_BLOCK_MS);
+  if (xTimerChangePeriod(refresh_timer, pdMS_TO_TICKS(delay_ms), block) ==
+      pdPASS) {
+    refresh_rearm_ms = 0;
+  } else {
+    ESP_LOGW(TAG, "Timer queue full, retrying the scores refresh later");
+    refresh_rearm_ms = delay_ms;
   }
+}
 
-  if (response_buffer)
-    free(response_buffer);
-  vTaskDelete(NULL);
+static void scores_fetch_done(const net_response_t *resp, void *ctx) {
+  if (resp->err == ESP_OK && resp->status == 200) {
+    ESP_LOGI(TAG, "Read %d bytes", resp->len);
+    parse_scores_json(resp->body);
+  } else {
+    ESP_LOGE(TAG, "Scores fetch failed: %s (HTTP %d)",
+             esp_err_to_name(resp->err), resp->status);
+  }
+  schedule_refresh(REFRESH_INTERVAL_MS);
+}
+
+// Runs on the timer service task; only queues work for the network task
+static void refresh_timer_cb(TimerHandle_t timer) {
+  // TLS needs a valid clock; the RTC usually provides one at boot
+  if (!espwifi_is_connected() || !time_service_is_valid()) {
+    schedule_refresh(NOT_READY_RETRY_MS);
+    return;
+  }
+
+  ESP_LOGI(TAG, "Fetching scores...");
+  net_request_t req = {
+      .url = scores_url,
+      .priority = NET_PRIO_SCORES,
+      .max_body = SCORES_MAX_BODY,
+      .timeout_ms = 10000,
+      .on_done = scores_fetch_done,
+  };
+  if (!net_service_submit(&req)) {
+    schedule_refresh(NOT_READY_RETRY_MS);
+  }
 }
 
 void sports_scores_init(void) {
-  games_mutex = xSemaphoreCreateMutex();
-  xTaskCreate(http_test_task, "curr_games_task", 20480, NULL, 5, NULL);
+  scores_lazy_init();
+  rotate_timer = xTimerCreate("scores_rotate", pdMS_TO_TICKS(ROTATE_INTERVAL_MS),
+                              pdTRUE, NULL, rotate_timer_cb);
+  if (rotate_timer) {
+    xTimerStart(rotate_timer, 0);
+  }
+
+  // Build ESPN API URL dynamically from configuration
+#ifdef SCORES_API_URL_OVERRIDE
+  snprintf(scores_url, sizeof(scores_url), "%s", SCORES_API_URL_OVERRIDE);
+#else
+  snprintf(scores_url, sizeof(scores_url),
+           "https://site.api.espn.com/apis/site/v2/sports/%s/%s/"
+           "scoreboard?groups=%s&limit=20",
+           SPORT_TYPE, LEAGUE_TYPE, LEAGUE_GROUP);
+#endif
+
+  // One-shot; rearmed after every fetch so requests never overlap
+  refresh_timer = xTimerCreate("scores_refresh", pdMS_TO_TICKS(100), pdFALSE,
+                               NULL, refresh_timer_cb);
+  if (refresh_timer) {
+    xTimerStart(refresh_timer, 0);
+  }
 }
 
 int sports_scores_get_games(game_info_t *games, int max_to_get) {
   if (!games_mutex || games_count == 0 || max_to_get <= 0)
     return 0;
 
-  // Rotate every 15 seconds for two games
-  int base_index =
-      (xTaskGetTickCount() * portTICK_PERIOD_MS / 15000) % games_count;
-
   xSemaphoreTake(games_mutex, portMAX_DELAY);
+  if (games_count == 0) {
+    xSemaphoreGive(games_mutex);
+    return 0;
+  }
+  // Rotation advances every 15 seconds (SCORE_EVENT_ROTATE)
+  int base_index = rotation_base % games_count;
   int count = 0;
   for (int i = 0; i < max_to_get && i < games_count; i++) {
     int idx = (base_index + i) % games_count;
@@ -328,3 +373,90 @@ int sports_scores_get_games(game_info_t *games, int max_to_get) {
   xSemaphoreGive(games_mutex);
   return count;
 }
+
+QueueHandle_t sports_scores_get_event_queue(void) {
+  scores_lazy_init();
+  return score_event_queue;
+}
+
+bool sports_scores_restore_snapshot(time_t *fetched_at) {
+  scores_lazy_init();
+
+  nvs_handle_t nvs;
+  if (nvs_open(SNAPSHOT_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK)
+    return false;
+
+  size_t max_size = sizeof(scores_snapshot_t) +
+                    SNAPSHOT_MAX_TEAMS * sizeof(team_info_t) +
+                    MAX_GAMES * sizeof(game_info_t);
+  size_t size = 0;
+  esp_err_t err = nvs_get_blob(nvs, SNAPSHOT_KEY, NULL, &size);
+  if (err != ESP_OK || size < sizeof(scores_snapshot_t) || size > max_size) {
+    nvs_close(nvs);
+    return false;
+  }
+
+  scores_snapshot_t *snap = malloc(size);
+  if (!snap) {
+    nvs_close(nvs);
+    return false;
+  }
+  err = nvs_get_blob(nvs, SNAPSHOT_KEY, snap, &size);
+  nvs_close(nvs);
+
+  const team_info_t *teams = (const team_info_t *)(snap + 1);
+  size_t payload = size - sizeof(scores_snapshot_t);
+  bool ok = err == ESP_OK && snap->version == SNAPSHOT_VERSION &&
+            snap->count <= MAX_GAMES &&
+            snap->team_count <= SNAPSHOT_MAX_TEAMS &&
+            payload == snap->team_count * sizeof(team_info_t) +
+                           snap->count * sizeof(game_info_t) &&
+            hash_bytes(teams, payload) == snap->hash;
+
+  game_info_t games[MAX_GAMES];
+  if (ok) {
+    // Re-intern the stored teams and map games back to registry handles
+    team_handle_t handles[SNAPSHOT_MAX_TEAMS];
+    for (int i = 0; i < snap->team_count; i++) {
+      handles[i] = team_registry_intern_info(&teams[i]);
+    }
+    memcpy(games, teams + snap->team_count, snap->count * sizeof(game_info_t));
+    for (int i = 0; i < snap->count; i++) {
+      games[i].away_team = games[i].away_team < snap->team_count
+                               ? handles[games[i].away_team]
+                               : TEAM_HANDLE_NONE;
+      games[i].home_team = games[i].home_team < snap->team_count
+                               ? handles[games[i].home_team]
+                               : TEAM_HANDLE_NONE;
+    }
+
+    xSemaphoreTake(games_mutex, portMAX_DELAY);
+    // Never clobber live data with the snapshot
+    if (games_count == 0) {
+      memcpy(games_cache, games, snap->count * sizeof(game_info_t));
+      games_count = snap->count;
+      snapshot_stale = true;
+      snapshot_fetched_at = (time_t)snap->fetched_at;
+    } else {
+      ok = false;
+    }
+    xSemaphoreGive(games_mutex);
+  }
+
+  if (ok) {
+    // The stored content is already on flash; don't rewrite it unchanged.
+    // The first changed fetch is still saved right away.
+    last_saved_hash = snap->hash;
+    last_saved_hash_valid = true;
+    if (fetched_at)
+      *fetched_at = snapshot_fetched_at;
+    ESP_LOGI(TAG, "Restored scoreboard snapshot (%d games, %d teams)",
+             snap->count, snap->team_count);
+  } else {
+    ESP_LOGW(TAG, "No usable scoreboard snapshot");
+  }
+  free(snap);
+  return ok;
+}
+
+bool sports_scores_is_stale(void) { return snapshot_stale; }
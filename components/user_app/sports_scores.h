@@ -2,16 +2,56 @@
 #define SPORTS_SCORES_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include "dashboard_screen.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+// Deltas emitted after each scoreboard parse (and by the rotation timer)
+typedef enum {
+  SCORE_EVENT_SCORE_CHANGED = 0, // Either team's score changed
+  SCORE_EVENT_STATUS_CHANGED,    // Clock/period/state text changed
+  SCORE_EVENT_GAME_ADDED,        // Game entered the filtered list
+  SCORE_EVENT_GAME_REMOVED,      // Game left the filtered list
+  SCORE_EVENT_ROTATE,            // Visible game window advanced (game_id 0)
+  SCORE_EVENT_LIVE,              // First live fetch replaced the snapshot
+} score_event_type_t;
+
+typedef struct {
+  score_event_type_t type;
+  uint32_t game_id; // ESPN event ID (game_info_t.id)
+} score_event_t;
 
 void sports_scores_init(void);
 int sports_scores_get_games(game_info_t *games, int max_to_get);
 
+/**
+ * @brief Queue of score_event_t produced by the scores module
+ * @return Queue handle, created on first use
+ */
+QueueHandle_t sports_scores_get_event_queue(void);
+
+/**
+ * @brief Load the last persisted scoreboard for an instant first paint
+ * @note NVS must be initialized. The data is marked stale until the first
+ * live fetch replaces it (SCORE_EVENT_LIVE).
+ * @param fetched_at Optional output: UNIX time the snapshot was fetched
+ * @return true if a valid snapshot was restored
+ */
+bool sports_scores_restore_snapshot(time_t *fetched_at);
+
+/**
+ * @brief Check whether the cached games come from the persisted snapshot
+ * @return true until the first live fetch completes
+ */
+bool sports_scores_is_stale(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,127 @@
+#include "team_registry.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "TeamRegistry";
+
+#define ESPN_CDN_HOST "espncdn.com"
+
+// Append-only table: entries never change once published, so readers only
+// need the published count, not the lock
+static team_info_t *teams = NULL;
+static uint16_t team_count = 0;
+static SemaphoreHandle_t teams_mutex = NULL;
+
+// Derive the team ID from a logo URL
+// URL format: https://a.espncdn.com/i/teamlogos/ncaa/500/145.png
+static uint32_t team_id_from_logo(const char *url) {
+  const char *png = strstr(url, ".png");
+  if (!png)
+    return 0;
+
+  const char *last_slash = NULL;
+  for (const char *p = url; p < png; p++) {
+    if (*p == '/')
+      last_slash = p;
+  }
+  if (!last_slash)
+    return 0;
+
+  return strtoul(last_slash + 1, NULL, 10);
+}
+
+static void set_logo_path(team_info_t *team, const char *logo_url) {
+  team->logo_path[0] = '\0';
+  if (!logo_url)
+    return;
+
+  // Keep only the path on the CDN; every logo lives on the same host
+  const char *cdn = strstr(logo_url, ESPN_CDN_HOST);
+  const char *path = cdn ? strchr(cdn, '/') : NULL;
+  if (!path || strlen(path) >= sizeof(team->logo_path)) {
+    ESP_LOGW(TAG, "Unsupported logo URL for %s", team->abbrev);
+    return;
+  }
+  strcpy(team->logo_path, path);
+}
+
+// Find or add a team; the new entry is filled from either info or logo_url
+static team_handle_t intern_team(const char *abbrev, uint32_t espn_id,
+                                 const char *logo_url,
+                                 const team_info_t *info) {
+  if (!teams_mutex) {
+    teams_mutex = xSemaphoreCreateMutex();
+  }
+  xSemaphoreTake(teams_mutex, portMAX_DELAY);
+
+  if (!teams) {
+    teams = heap_caps_calloc(MAX_TEAMS, sizeof(team_info_t), MALLOC_CAP_SPIRAM);
+    if (!teams) {
+      xSemaphoreGive(teams_mutex);
+      ESP_LOGE(TAG, "Failed to allocate team table");
+      return TEAM_HANDLE_NONE;
+    }
+  }
+
+  team_handle_t handle = TEAM_HANDLE_NONE;
+  for (uint16_t i = 0; i < team_count; i++) {
+    bool match = espn_id ? teams[i].espn_id == espn_id
+                         : strncmp(teams[i].abbrev, abbrev,
+                                   sizeof(teams[i].abbrev) - 1) == 0;
+    if (match) {
+      handle = i;
+      break;
+    }
+  }
+
+  if (handle == TEAM_HANDLE_NONE) {
+    if (team_count < MAX_TEAMS) {
+      team_info_t *team = &teams[team_count];
+      if (info) {
+        *team = *info;
+        team->abbrev[sizeof(team->abbrev) - 1] = '\0';
+        team->logo_path[sizeof(team->logo_path) - 1] = '\0';
+      } else {
+        strncpy(team->abbrev, abbrev, sizeof(team->abbrev) - 1);
+        team->espn_id = espn_id;
+        set_logo_path(team, logo_url);
+      }
+      handle = team_count;
+      // Publish the entry only after it is fully written
+      __atomic_store_n(&team_count, team_count + 1, __ATOMIC_RELEASE);
+    } else {
+      ESP_LOGW(TAG, "Team table full, dropping %s", abbrev);
+    }
+  }
+
+  xSemaphoreGive(teams_mutex);
+  return handle;
+}
+
+team_handle_t team_registry_intern(const char *abbrev, uint32_t espn_id,
+                                   const char *logo_url) {
+  if (espn_id == 0 && logo_url)
+    espn_id = team_id_from_logo(logo_url);
+  return intern_team(abbrev ? abbrev : "", espn_id, logo_url, NULL);
+}
+
+team_handle_t team_registry_intern_info(const team_info_t *info) {
+  if (!info)
+    return TEAM_HANDLE_NONE;
+  return intern_team(info->abbrev, info->espn_id, NULL, info);
+}
+
+const team_info_t *team_registry_get(team_handle_t handle) {
+  if (handle >= __atomic_load_n(&team_count, __ATOMIC_ACQUIRE))
+    return NULL;
+  return &teams[handle];
+}
+
+const char *team_registry_abbrev(team_handle_t handle) {
+  const team_info_t *team = team_registry_get(handle);
+  return team ? team->abbrev : "?";
+}
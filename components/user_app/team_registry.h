@@ -0,0 +1,56 @@
+#ifndef TEAM_REGISTRY_H
+#define TEAM_REGISTRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Teams are interned once and referenced from game records by handle
+typedef uint16_t team_handle_t;
+#define TEAM_HANDLE_NONE 0xFFFF
+
+#define MAX_TEAMS 256
+
+typedef struct {
+  char abbrev[8];      // "UK", "ALA"
+  uint32_t espn_id;    // ESPN team ID (also the logo file name)
+  char logo_path[64];  // Path on a.espncdn.com, e.g. /i/teamlogos/ncaa/500/96.png
+} team_info_t;
+
+/**
+ * @brief Look up a team, adding it to the registry if it is new
+ * @param abbrev Team abbreviation (may be NULL)
+ * @param espn_id ESPN team ID, or 0 to derive it from the logo URL
+ * @param logo_url Logo URL as served in the scoreboard JSON (may be NULL)
+ * @return Handle for the team, or TEAM_HANDLE_NONE if the registry is full
+ */
+team_handle_t team_registry_intern(const char *abbrev, uint32_t espn_id,
+                                   const char *logo_url);
+
+/**
+ * @brief Intern a complete team entry (e.g. one restored from storage)
+ * @param info Team to add; an existing team with the same ID wins
+ * @return Handle for the team, or TEAM_HANDLE_NONE if the registry is full
+ */
+team_handle_t team_registry_intern_info(const team_info_t *info);
+
+/**
+ * @brief Get an interned team
+ * @param handle Handle returned by team_registry_intern
+ * @return Team entry (valid for the lifetime of the program) or NULL
+ */
+const team_info_t *team_registry_get(team_handle_t handle);
+
+/**
+ * @brief Get a team's abbreviation, with a placeholder for unknown handles
+ */
+const char *team_registry_abbrev(team_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEAM_REGISTRY_H
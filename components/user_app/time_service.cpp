@@ -0,0 +1,275 @@
+#include "time_service.h"
+#include "esp_timer.h"
+#include "i2c_equipment.h"
+#include "nvs.h"
+#include "sensor_service.h"
+#include "sntp_bsp.h"
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static const char *TAG = "TimeService";
+
+#define TIME_NVS_NAMESPACE "time"
+#define TIME_MIN_VALID_YEAR 2024
+#define TIME_HALF_US 500000
+#define TIME_TICK_LATE_US 300 // Fire just after the boundary, never before
+
+static volatile time_state_t base_state = TIME_UNSET;
+static volatile int64_t last_sync_us = 0; // esp_timer time of the last NTP sync
+
+// Persisted: when the RTC was last set from NTP, and its measured drift
+static int64_t rtc_set_epoch = 0;
+static int32_t drift_ppb = 0;
+
+// Local time cache. localtime_r (TZ rule evaluation) only runs at local
+// midnight, at a DST change or after the clock is stepped; every other
+// second is derived from the cached UTC offset.
+static esp_timer_handle_t tick_timer = NULL;
+static portMUX_TYPE local_lock = portMUX_INITIALIZER_UNLOCKED;
+static struct tm local_cache;
+static bool local_first_half = true;
+static time_t cached_sec = 0;     // UTC second local_cache describes
+static int32_t utc_offset = 0;    // Local minus UTC, seconds
+static time_t next_recompute = 0; // Next local midnight or DST change
+static volatile bool force_recompute = true;
+static time_event_cb_t event_cb = NULL;
+static void *event_ctx = NULL;
+
+time_t time_service_utc_to_epoch(const struct tm *utc) {
+  // Days from civil (Howard Hinnant's algorithm)
+  int y = utc->tm_year + 1900;
+  unsigned m = utc->tm_mon + 1;
+  y -= m <= 2;
+  int era = (y >= 0 ? y : y - 399) / 400;
+  unsigned yoe = (unsigned)(y - era * 400);
+  unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + utc->tm_mday - 1;
+  unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  int64_t days = (int64_t)era * 146097 + (int64_t)doe - 719468;
+  return (time_t)(days * 86400 + utc->tm_hour * 3600 + utc->tm_min * 60 +
+                  utc->tm_sec);
+}
+
+static void load_calibration(void) {
+  nvs_handle_t nvs;
+  if (nvs_open(TIME_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK)
+    return;
+  nvs_get_i64(nvs, "rtc_set", &rtc_set_epoch);
+  nvs_get_i32(nvs, "drift_ppb", &drift_ppb);
+  nvs_close(nvs);
+}
+
+static void save_calibration(void) {
+  nvs_handle_t nvs;
+  if (nvs_open(TIME_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK)
+    return;
+  nvs_set_i64(nvs, "rtc_set", rtc_set_epoch);
+  nvs_set_i32(nvs, "drift_ppb", drift_ppb);
+  nvs_commit(nvs);
+  nvs_close(nvs);
+}
+
+// First second in (from, to] whose DST flag differs from from's
+static time_t find_dst_change(time_t from, time_t to, int isdst) {
+  while (to - from > 1) {
+    time_t mid = from + (to - from) / 2;
+    struct tm probe;
+    localtime_r(&mid, &probe);
+    if (probe.tm_isdst == isdst)
+      from = mid;
+    else
+      to = mid;
+  }
+  return to;
+}
+
+// Called with local_lock not held; full TZ evaluation
+static void recompute_local(time_t now, struct tm *out) {
+  localtime_r(&now, out);
+  utc_offset = (int32_t)(time_service_utc_to_epoch(out) - now);
+
+  time_t midnight =
+      now - (out->tm_hour * 3600 + out->tm_min * 60 + out->tm_sec) + 86400;
+  next_recompute = midnight;
+  struct tm probe;
+  localtime_r(&midnight, &probe);
+  if (probe.tm_isdst != out->tm_isdst) {
+    next_recompute = find_dst_change(now, midnight, out->tm_isdst);
+  }
+}
+
+static void tick_cb(void *arg) {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  int64_t now_us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+
+  // Nearest half-second boundary; the timer fires just after it
+  int64_t half = (now_us + TIME_HALF_US / 2) / TIME_HALF_US;
+  time_t sec = (time_t)(half / 2);
+  bool first_half = (half % 2) == 0;
+  uint32_t events = 0;
+
+  if (first_half) {
+    struct tm next;
+    events |= TIME_EVENT_SECOND;
+
+    portENTER_CRITICAL(&local_lock);
+    next = local_cache;
+    portEXIT_CRITICAL(&local_lock);
+
+    bool stepped = sec != cached_sec + 1;
+    if (force_recompute || stepped || sec >= next_recompute) {
+      int old_yday = next.tm_yday;
+      int old_year = next.tm_year;
+      recompute_local(sec, &next);
+      events |= TIME_EVENT_MINUTE;
+      if (force_recompute || stepped || next.tm_yday != old_yday ||
+          next.tm_year != old_year) {
+        events |= TIME_EVENT_DAY;
+      }
+      force_recompute = false;
+    } else {
+      int32_t sod = (int32_t)((sec + utc_offset) % 86400);
+      next.tm_hour = sod / 3600;
+      next.tm_min = (sod / 60) % 60;
+      next.tm_sec = sod % 60;
+      if (next.tm_sec == 0)
+        events |= TIME_EVENT_MINUTE;
+    }
+    cached_sec = sec;
+
+    portENTER_CRITICAL(&local_lock);
+    local_cache = next;
+    local_first_half = true;
+    portEXIT_CRITICAL(&local_lock);
+  } else {
+    events |= TIME_EVENT_HALF;
+    portENTER_CRITICAL(&local_lock);
+    local_first_half = false;
+    portEXIT_CRITICAL(&local_lock);
+  }
+
+  int64_t next_us = (half + 1) * TIME_HALF_US + TIME_TICK_LATE_US;
+  esp_timer_start_once(tick_timer, next_us - now_us);
+
+  time_event_cb_t cb = event_cb;
+  if (cb) {
+    cb(events, event_ctx);
+  }
+}
+
+static void start_ticks(void) {
+  esp_timer_create_args_t args = {};
+  args.callback = tick_cb;
+  args.name = "time_tick";
+  if (esp_timer_create(&args, &tick_timer) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create tick timer");
+    return;
+  }
+  esp_timer_start_once(tick_timer, TIME_TICK_LATE_US);
+}
+
+void time_service_set_event_cb(time_event_cb_t cb, void *ctx) {
+  event_ctx = ctx;
+  event_cb = cb;
+  force_recompute = true;
+}
+
+void time_service_get_local(struct tm *out, bool *first_half) {
+  portENTER_CRITICAL(&local_lock);
+  *out = local_cache;
+  if (first_half)
+    *first_half = local_first_half;
+  portEXIT_CRITICAL(&local_lock);
+}
+
+// Runs on the SNTP task: only record the event and hand the RTC write to
+// the sensor task, which owns the I2C devices
+static void on_ntp_sync(void) {
+  last_sync_us = esp_timer_get_time();
+  base_state = TIME_SYNCED;
+  force_recompute = true; // The clock may have been stepped
+  sensor_service_request_rtc_sync();
+}
+
+static void seed_from_rtc(void) {
+  rtcTimeStruct_t rtc;
+  Rtc_GetTime(&rtc);
+  if (rtc.year < TIME_MIN_VALID_YEAR) {
+    ESP_LOGW(TAG, "RTC not set, waiting for NTP");
+    return;
+  }
+
+  struct tm utc = {};
+  utc.tm_year = rtc.year - 1900;
+  utc.tm_mon = rtc.month - 1;
+  utc.tm_mday = rtc.day;
+  utc.tm_hour = rtc.hour;
+  utc.tm_min = rtc.minute;
+  utc.tm_sec = rtc.second;
+  time_t now = time_service_utc_to_epoch(&utc);
+
+  // Take out the drift accumulated since the RTC was last set
+  int32_t correction = 0;
+  if (rtc_set_epoch > 0 && now > rtc_set_epoch) {
+    correction = (int32_t)((now - rtc_set_epoch) * (int64_t)drift_ppb /
+                           1000000000LL);
+    now -= correction;
+  }
+
+  struct timeval tv = {.tv_sec = now, .tv_usec = 0};
+  settimeofday(&tv, NULL);
+  base_state = TIME_HOLDOVER;
+
+  struct tm local;
+  localtime_r(&now, &local);
+  ESP_LOGI(TAG, "Clock set from RTC: %04d-%02d-%02d %02d:%02d:%02d (drift "
+                "correction %lds)",
+           local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+           local.tm_hour, local.tm_min, local.tm_sec, (long)correction);
+}
+
+void time_service_init(void) {
+  setenv("TZ", SNTP_TIMEZONE, 1);
+  tzset();
+  sntp_time_set_sync_cb(on_ntp_sync);
+  load_calibration();
+  seed_from_rtc();
+  start_ticks();
+}
+
+time_state_t time_service_get_state(void) {
+  time_state_t state = base_state;
+  if (state == TIME_SYNCED &&
+      esp_timer_get_time() - last_sync_us > (int64_t)TIME_SYNC_STALE_S * 1000000) {
+    return TIME_HOLDOVER;
+  }
+  return state;
+}
+
+bool time_service_is_valid(void) { return base_state != TIME_UNSET; }
+
+float time_service_get_drift_ppm(void) { return drift_ppb / 1000.0f; }
+
+bool time_service_rtc_check(int32_t rtc_offset_s, bool rtc_was_valid) {
+  time_t now = time(NULL);
+  int64_t span = now - rtc_set_epoch;
+
+  if (rtc_was_valid && rtc_set_epoch > 0) {
+    // Still within a second and too soon to measure: let the error build up
+    // so the next estimate spans a useful interval
+    if (rtc_offset_s == 0 && span < TIME_DRIFT_MIN_SPAN_S)
+      return false;
+
+    if (span >= TIME_DRIFT_MIN_SPAN_S) {
+      drift_ppb = (int32_t)((int64_t)rtc_offset_s * 1000000000LL / span);
+      ESP_LOGI(TAG, "RTC off by %lds over %lldh: %.2f ppm", (long)rtc_offset_s,
+               (long long)span / 3600, drift_ppb / 1000.0f);
+    }
+  }
+
+  rtc_set_epoch = now;
+  save_calibration();
+  return true;
+}
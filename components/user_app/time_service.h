@@ -0,0 +1,89 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// After this long without an NTP sync the clock is reported as holdover
+#define TIME_SYNC_STALE_S (6 * 3600)
+
+// Drift is only estimated over spans at least this long (1 s RTC resolution)
+#define TIME_DRIFT_MIN_SPAN_S (6 * 3600)
+
+// Boundary events, OR-ed together when several coincide
+#define TIME_EVENT_SECOND 0x01 // Start of a second (colon on)
+#define TIME_EVENT_HALF 0x02   // Half past the second (colon off)
+#define TIME_EVENT_MINUTE 0x04 // Also sent after a clock step or DST change
+#define TIME_EVENT_DAY 0x08    // Also sent after a clock step
+
+/**
+ * @brief Boundary callback, run on the esp_timer task; keep it short
+ */
+typedef void (*time_event_cb_t)(uint32_t events, void *ctx);
+
+typedef enum {
+  TIME_UNSET = 0, // No RTC time and no NTP yet
+  TIME_HOLDOVER,  // Running from the RTC, or NTP has not answered lately
+  TIME_SYNCED     // Disciplined by NTP within TIME_SYNC_STALE_S
+} time_state_t;
+
+/**
+ * @brief Seed the system clock from the PCF85063, corrected for the drift
+ * measured on earlier syncs
+ * @note Call after sensor_service_init() (RTC bring-up) and NVS init, before
+ * the sensor task starts
+ */
+void time_service_init(void);
+
+/**
+ * @brief Register the boundary callback; the next second boundary also
+ * reports MINUTE and DAY so the receiver can paint everything once
+ */
+void time_service_set_event_cb(time_event_cb_t cb, void *ctx);
+
+/**
+ * @brief Cached broken-down local time, refreshed on each second boundary
+ * @param out Local time
+ * @param first_half Optional: true during the first half of the second
+ */
+void time_service_get_local(struct tm *out, bool *first_half);
+
+/**
+ * @brief Current clock state
+ */
+time_state_t time_service_get_state(void);
+
+/**
+ * @brief true once the wall clock can be trusted (synced or holdover)
+ */
+bool time_service_is_valid(void);
+
+/**
+ * @brief Last measured RTC drift, parts per million (positive = RTC fast)
+ */
+float time_service_get_drift_ppm(void);
+
+/**
+ * @brief Called by the sensor task with the RTC read back after an NTP sync;
+ * updates the drift estimate
+ * @param rtc_offset_s RTC minus system time, whole seconds
+ * @param rtc_was_valid false if the RTC held no usable time
+ * @return true if the RTC should now be rewritten from system time
+ */
+bool time_service_rtc_check(int32_t rtc_offset_s, bool rtc_was_valid);
+
+/**
+ * @brief struct tm in UTC to epoch seconds (newlib has no timegm)
+ */
+time_t time_service_utc_to_epoch(const struct tm *utc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIME_SERVICE_H
@@ -1,133 +1,301 @@
 #include "user_app.h"
-#include "adc_bsp.h"
+#include "boot_profile.h"
+#include "button_bsp.h"
+#include "climate_history.h"
+#include "compositor.h"
+#include "dashboard_model.h"
 #include "dashboard_screen.h"
 #include "esp_wifi_bsp.h"
-#include "i2c_bsp.h"
-#include "i2c_equipment.h"
+#include "job_sched.h"
 #include "logo_fetcher.h"
 #include "lvgl_bsp.h"
+#include "net_service.h"
+#include "night_mode.h"
+#include "pm_bsp.h"
 #include "sdcard_bsp.h"
+#include "sensor_log.h"
+#include "sensor_service.h"
 #include "sntp_bsp.h"
 #include "sports_scores.h"
+#include "time_service.h"
 #include <esp_log.h>
+#include <freertos/event_groups.h>
 #include <freertos/freeRTOS.h>
 #include <stdio.h>
 
 static const char *TAG = "UserApp";
 
-// I2C bus and sensors
-I2cMasterBus I2cbus(14, 13, 0);
-Shtc3Port *shtc3port = NULL;
+// Set by the storage task once the SD card is mounted (or found missing)
+#define BOOT_STORAGE_READY (1 << 0)
+#define BOOT_STORAGE_WAIT_MS 2000
+static EventGroupHandle_t boot_events = NULL;
+
+// Set from the network task when a logo download lands
+static volatile bool logos_ready = false;
+
+static void on_logo_ready(team_handle_t team, void *ctx) { logos_ready = true; }
+
+// Boundary events from the time service, delivered as notification bits
+static TaskHandle_t dashboard_task = NULL;
+
+static void on_time_event(uint32_t events, void *ctx) {
+  xTaskNotify(dashboard_task, events, eSetBits);
+}
+
+// When the restored scoreboard snapshot was fetched (UNIX time, 0 if none)
+static time_t scores_fetched_at = 0;
+
+// Age shown on the "CACHED" tag, in minutes; -1 until the clock is valid
+static int scores_age_min(void) {
+  if (!scores_fetched_at || !time_service_is_valid())
+    return -1;
+  time_t now = time(NULL);
+  return now > scores_fetched_at ? (int)((now - scores_fetched_at) / 60) : 0;
+}
+
+// Redraw the climate sparklines from the 10 minute history (last 24 h),
+// falling back to the 1 minute level until the first 10 minute buckets close
+static void apply_climate_history(void) {
+  static history_bucket_t buckets[HISTORY_MAX_BUCKETS];
+  static int16_t temp[HISTORY_MAX_BUCKETS];
+  static int16_t humidity[HISTORY_MAX_BUCKETS];
+
+  history_level_t level = HISTORY_10MIN;
+  if (climate_history_read(HISTORY_TEMP_C, level, buckets, 2) < 2) {
+    level = HISTORY_1MIN;
+  }
+
+  int temp_n = climate_history_read(HISTORY_TEMP_C, level, buckets,
+                                    HISTORY_MAX_BUCKETS);
+  for (int i = 0; i < temp_n; i++) {
+    temp[i] = buckets[i].mean;
+  }
+  int humidity_n = climate_history_read(HISTORY_HUMIDITY, level, buckets,
+                                        HISTORY_MAX_BUCKETS);
+  for (int i = 0; i < humidity_n; i++) {
+    humidity[i] = buckets[i].mean;
+  }
+
+  dashboard_model_set_history(temp, temp_n, humidity, humidity_n);
+}
+
+// ========== DASHBOARD JOBS ==========
+// Polled sources, run by the dashboard task's scheduler. Each only feeds
+// the model; dashboard_commit() draws after the batch.
+
+// The scores module diffs each parse and pushes deltas
+static void job_scores(void *ctx) {
+  QueueHandle_t score_events = (QueueHandle_t)ctx;
+  score_event_t ev;
+  bool scores_dirty = false;
+  bool scored = false;
+  uint32_t scored_id = 0;
+  while (xQueueReceive(score_events, &ev, 0) == pdTRUE) {
+    scores_dirty = true;
+    if (ev.type == SCORE_EVENT_SCORE_CHANGED) {
+      scored = true;
+      scored_id = ev.game_id;
+    }
+  }
+  if (scores_dirty) {
+    game_info_t games[2];
+    int count = sports_scores_get_games(games, 2);
+    dashboard_model_set_scores(games, count);
+    dashboard_model_set_scores_stale(sports_scores_is_stale(),
+                                     scores_age_min());
+    if (scored) {
+      dashboard_model_highlight(scored_id);
+    }
+  }
+}
+
+static void job_logos(void *ctx) {
+  if (logos_ready) {
+    logos_ready = false;
+    dashboard_model_refresh_logos();
+  }
+}
+
+// NTP vs RTC holdover
+static void job_clock_source(void *ctx) {
+  static time_state_t shown_time_state = TIME_UNSET;
+  time_state_t time_state = time_service_get_state();
+  if (time_state != shown_time_state) {
+    dashboard_model_set_clock_synced(time_state == TIME_SYNCED);
+    shown_time_state = time_state;
+  }
+}
+
+// Readings come from the acquisition task; the model drops those that look
+// the same at the displayed precision
+static void job_sensors(void *ctx) {
+  static uint32_t shown_sensors = 0;
+  sensor_snapshot_t sensors;
+  sensor_service_read(&sensors);
+  if (sensors.version == shown_sensors) {
+    return;
+  }
+  if (sensors.battery_valid) {
+    dashboard_model_set_battery(sensors.battery_percent);
+  }
+  dashboard_model_set_wifi(sensors.rssi, sensors.wifi_connected);
+
+  // Initialize SNTP once WiFi connects
+  static bool sntp_started = false;
+  if (sensors.wifi_connected && !sntp_started) {
+    sntp_time_init();
+    sntp_started = true;
+    ESP_LOGI(TAG, "Started SNTP sync");
+  }
+
+  if (sensors.climate_valid) {
+    dashboard_model_set_climate(sensors.temp_c, sensors.humidity);
+  }
+  shown_sensors = sensors.version;
+}
+
+// Only when a history bucket has closed (about once a minute)
+static void job_climate_history(void *ctx) {
+  static uint32_t shown_history = 0;
+  uint32_t history = climate_history_version();
+  if (history != shown_history) {
+    apply_climate_history();
+    shown_history = history;
+  }
+}
+
+static void job_stats(void *ctx) {
+  sched_log_stats((const job_sched_t *)ctx);
+  dashboard_model_log_stats();
+  sensor_service_log_bus_stats();
+}
 
 // Dashboard update task
 void Dashboard_UpdateTask(void *arg) {
-  uint32_t ticks = 0;
+  static job_sched_t sched;
+  uint32_t time_events = 0;
+
+  dashboard_model_init();
+  dashboard_task = xTaskGetCurrentTaskHandle();
+  time_service_set_event_cb(on_time_event, NULL);
 
-  // Wait for WiFi and NTP sync
-  ESP_LOGI(TAG, "Waiting for time sync...");
+  // Period, then how late each may run so it can share a wake-up with the
+  // others or with the clock's half-second events
+  sched_init(&sched, "dashboard");
+  sched_add(&sched, "scores", job_scores, sports_scores_get_event_queue(),
+            1000, 500);
+  sched_add(&sched, "logos", job_logos, NULL, 1000, 500);
+  sched_add(&sched, "clock_src", job_clock_source, NULL, 1000, 500);
+  sched_add(&sched, "sensors", job_sensors, NULL, 1000, 500);
+  sched_add(&sched, "history", job_climate_history, NULL, 10 * 1000,
+            5 * 1000);
+  sched_add(&sched, "stats", job_stats, &sched, DASHBOARD_STATS_PERIOD_MS,
+            60 * 1000);
 
   for (;;) {
-    if (Lvgl_lock(LVGL_TASK_MAX_DELAY_MS)) {
-      // ========== UPDATE TIME ==========
-      // Update frequently for blinking colon
-      {
-        int hours, minutes, seconds;
-
-        if (sntp_time_is_synced()) {
-          sntp_get_hms(&hours, &minutes, &seconds);
-        } else {
-          hours = 0;
-          minutes = 0;
-          seconds = 0;
-        }
-
-        // Blink colon: approx 600ms ON, 400ms OFF
-        bool colon_visible = (ticks % 5) < 3;
-        dashboard_update_time(hours, minutes, colon_visible);
-      }
+    bool night_due = false;
 
-      // ========== UPDATE SCORES (every 1 second) ==========
-      if (ticks % 5 == 0) {
-        game_info_t games[2];
-        int count = sports_scores_get_games(games, 2);
-        if (count > 0) {
-          dashboard_update_scores(games, count);
-        }
-      }
+    // ========== UPDATE TIME ==========
+    // Driven by the time service's boundary events: the colon follows the
+    // real second and the digits only change on a minute boundary
+    if (time_events & (TIME_EVENT_SECOND | TIME_EVENT_HALF)) {
+      struct tm local;
+      bool first_half;
+      time_service_get_local(&local, &first_half);
 
-      // ========== UPDATE DATE (faster initial, then 1 min) ==========
-      bool synced = sntp_time_is_synced();
-      static bool last_synced = false;
-      if ((synced && !last_synced) || (ticks % 300 == 0)) {
-        if (synced) {
-          struct tm timeinfo;
-          char date_str[32];
-          sntp_get_time(&timeinfo);
-          strftime(date_str, sizeof(date_str), "%b %d, %Y", &timeinfo);
-          dashboard_update_date(date_str);
-          last_synced = true;
-        }
+      // Valid from boot when the RTC was set; NTP refines it later
+      if (!time_service_is_valid()) {
+        local.tm_hour = 0;
+        local.tm_min = 0;
       }
+      dashboard_model_set_time(local.tm_hour, local.tm_min, first_half);
 
-      // ========== UPDATE BATTERY (every 10 seconds) ==========
-      if (ticks % 50 == 0) { // Every 10 seconds
-        uint8_t level = Adc_GetBatteryLevel();
-        dashboard_update_battery(level);
+      // ========== UPDATE DATE (day boundary or clock step) ==========
+      if ((time_events & TIME_EVENT_DAY) && time_service_is_valid()) {
+        char date_str[32];
+        strftime(date_str, sizeof(date_str), "%b %d, %Y", &local);
+        dashboard_model_set_date(date_str);
       }
 
-      // ========== UPDATE WIFI (every 5 seconds) ==========
-      if (ticks % 25 == 0) { // Every 5 seconds
-        bool connected = espwifi_is_connected();
-        int8_t rssi = espwifi_get_rssi();
-        dashboard_update_wifi(rssi, connected);
-
-        // Initialize SNTP once WiFi connects
-        static bool sntp_started = false;
-        if (connected && !sntp_started) {
-          sntp_time_init();
-          sntp_started = true;
-          ESP_LOGI(TAG, "Started SNTP sync");
-        }
+      // Quiet hours are checked once a minute; a cached scoreboard ages
+      if (time_events & TIME_EVENT_MINUTE) {
+        night_due = night_mode_due(&local);
+        dashboard_model_set_scores_stale(sports_scores_is_stale(),
+                                         scores_age_min());
       }
+    }
 
-      // ========== UPDATE CLIMATE (every 5 seconds) ==========
-      if (ticks % 25 == 0) { // Every 5 seconds
-        float rh, temp_c;
-        if (shtc3port->Shtc3_ReadTempHumi(&temp_c, &rh) == 0) {
-          // Convert Celsius to Fahrenheit
-          float temp_f = temp_c * 9.0f / 5.0f + 32.0f;
-          dashboard_update_climate(temp_f, rh);
-        }
-      }
+    // Whatever is due, on whichever wake-up got here first
+    sched_run(&sched);
+
+    // Everything gathered above reaches the widgets here, under one short
+    // LVGL lock; fields that did not change are skipped
+    dashboard_commit(LVGL_TASK_MAX_DELAY_MS);
 
-      Lvgl_unlock();
+    // Renders the night frame and deep sleeps; back here only if the
+    // network was busy
+    if (night_due) {
+      night_mode_enter();
     }
 
-    vTaskDelay(pdMS_TO_TICKS(200));
-    ticks++;
+    // Sleep until the next clock boundary or the latest point a job can
+    // still run on time, whichever comes first
+    time_events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &time_events, sched_ticks_to_wait(&sched));
   }
 }
 
-void UserApp_AppInit() {
-  ESP_LOGI(TAG, "Initializing application...");
-
-  // Initialize ADC for battery monitoring
-  Adc_PortInit();
-
-  // Initialize I2C sensor
-  shtc3port = new Shtc3Port(I2cbus);
-
-  // Initialize SD card for logo caching
+// SD mount runs beside WiFi bring-up and panel init
+static void storage_init_task(void *arg) {
+  int span = boot_profile_begin("sd_mount");
   // GPIO38=CLK, GPIO21=CMD, GPIO39=D0 (1-bit mode)
   static CustomSDPort *sdcard = new CustomSDPort("/sdcard", 38, 21, 39, 1);
   if (sdcard->SDPort_GetStatus()) {
     ESP_LOGI(TAG, "SD card mounted successfully");
+    sensor_log_init();
   } else {
     ESP_LOGW(TAG, "SD card not available - logos will be fetched each time");
   }
+  boot_profile_end(span);
 
-  // Initialize WiFi (will auto-connect to configured AP)
+  xEventGroupSetBits(boot_events, BOOT_STORAGE_READY);
+  vTaskDelete(NULL);
+}
+
+static void wait_for_storage(void) {
+  if (!(xEventGroupWaitBits(boot_events, BOOT_STORAGE_READY, pdFALSE, pdTRUE,
+                            pdMS_TO_TICKS(BOOT_STORAGE_WAIT_MS)) &
+        BOOT_STORAGE_READY)) {
+    ESP_LOGW(TAG, "SD card still mounting, continuing without it");
+  }
+}
+
+void UserApp_AppInit() {
+  ESP_LOGI(TAG, "Initializing application...");
+
+  // DFS and automatic light sleep; drivers below take PM locks as needed
+  Pm_PortInit();
+
+  // BOOT and KEY buttons: interrupt driven, and wake sources for light sleep
+  Custom_ButtonInit();
+
+  // Initialize SD card for logo caching and the sensor log
+  boot_events = xEventGroupCreate();
+  xTaskCreate(storage_init_task, "storage_init", 4 * 1024, NULL, 3, NULL);
+
+  // Initialize WiFi (will auto-connect to configured AP); association
+  // continues in the background
+  int span = boot_profile_begin("wifi_init");
   espwifi_init();
+  boot_profile_end(span);
+
+  // I2C bus and RTC; the SHTC3 and battery ADC come up on the sensor task
+  span = boot_profile_begin("rtc");
+  sensor_service_init();
+
+  // Clock from the RTC until NTP answers (needs NVS, set up by WiFi init)
+  time_service_init();
+  boot_profile_end(span);
 
   ESP_LOGI(TAG, "Application initialized");
 }
@@ -135,8 +303,11 @@ void UserApp_AppInit() {
 void UserApp_UiInit() {
   ESP_LOGI(TAG, "Creating dashboard UI...");
 
-  // Initialize logo fetcher (PNG decoder) - must be after LVGL init
+  // Initialize logo fetcher (PNG decoder) - must be after LVGL init, and
+  // after the SD mount so the cache directory is found
+  wait_for_storage();
   logo_fetcher_init();
+  logo_fetcher_set_ready_cb(on_logo_ready, NULL);
 
   // Get the current screen
   lv_obj_t *scr = lv_scr_act();
@@ -149,6 +320,19 @@ void UserApp_UiInit() {
   // Create the dashboard
   dashboard_create(scr);
 
+  // Borders, captions and dividers never change: bake them once so refreshes
+  // only render the widgets that did
+  compositor_bake(dashboard_get_static_layer());
+
+  // Paint the last known scoreboard right away; it is flagged stale until
+  // the first live fetch replaces it
+  if (sports_scores_restore_snapshot(&scores_fetched_at)) {
+    game_info_t games[2];
+    int count = sports_scores_get_games(games, 2);
+    dashboard_update_scores(games, count);
+    dashboard_set_scores_stale(true, scores_age_min());
+  }
+
   ESP_LOGI(TAG, "Dashboard UI created");
 }
 
@@ -159,6 +343,12 @@ void UserApp_TaskInit() {
   xTaskCreatePinnedToCore(Dashboard_UpdateTask, "Dashboard_Task", 8 * 1024,
                           NULL, 2, NULL, 1);
 
-  // Start sports scores task
+  // Periodic hardware reads, published as snapshots for the UI
+  sensor_service_start();
+
+  // Network worker shared by score refreshes and logo downloads
+  net_service_init();
+
+  // Start sports scores refresh
   sports_scores_init();
 }
@@ -4,36 +4,57 @@
 #include <esp_timer.h>
 #include <esp_log.h>
 
+#include "boot_profile.h"
+#include "compositor.h"
 #include "display_bsp.h"
 #include "lvgl_bsp.h"
+#include "night_mode.h"
 #include "user_app.h"
 
 DisplayPort RlcdPort(12,11,5,40,41,400,300);
 
 static void Lvgl_FlushCallback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
-  	uint16_t *buffer = (uint16_t *)color_map;
-  	for(int y = area->y1; y <= area->y2; y++) 
-  	{
-  	 	for(int x = area->x1; x <= area->x2; x++) 
-  	 	{
-  	 	   	uint8_t color = (*buffer < 0x7fff) ? ColorBlack : ColorWhite;
-  	 	   	RlcdPort.RLCD_SetPixel(x, y, color);
-  	 	   	buffer++;
-  	 	}
-  	}
-  	RlcdPort.RLCD_Display();
+	// Only the invalidated area, composited over the static layer
+	compositor_flush(area, color_map);
 	lv_disp_flush_ready(drv);
+	boot_profile_first_frame();
+}
+
+// Panel reset and init are mostly fixed delays; run them beside the rest of
+// the app bring-up
+static void Panel_InitTask(void *arg)
+{
+	int span = boot_profile_begin("panel_splash");
+	if (RlcdPort.RLCD_Init()) {
+		boot_profile_first_frame();
+	}
+	boot_profile_end(span);
+	xTaskNotifyGive((TaskHandle_t)arg);
+	vTaskDelete(NULL);
 }
 
 extern "C" void app_main(void)
 {
+	int span = boot_profile_begin("app_main");
+	// Quiet-hours clock wakes repaint and go back to sleep in here
+	bool panel_retained = night_mode_boot(&RlcdPort);
+	if (!panel_retained) {
+		xTaskCreatePinnedToCore(Panel_InitTask, "panel_init", 3 * 1024, xTaskGetCurrentTaskHandle(), 5, NULL, 1);
+	}
 	UserApp_AppInit();
-	RlcdPort.RLCD_Init();
+	if (!panel_retained) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+
+	int ui_span = boot_profile_begin("lvgl_ui");
+	compositor_init(&RlcdPort);
 	Lvgl_PortInit(400,300,Lvgl_FlushCallback);
 	if(Lvgl_lock(-1)) {
 		UserApp_UiInit();
   	  	Lvgl_unlock();
   	}
+	boot_profile_end(ui_span);
 	UserApp_TaskInit();
+	boot_profile_end(span);
 }
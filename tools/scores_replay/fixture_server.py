@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Serve recorded scoreboard fixtures in place of the ESPN API.
+
+Point the firmware at this server with SCORES_API_URL_OVERRIDE in
+sports_config.h, e.g. "http://192.168.1.50:8080/scoreboard".
+
+    python3 fixture_server.py --fixture live.json --chunk 1024 --latency 300
+
+Requests for /<name>.json serve that fixture; any other path serves the
+--fixture (or the next one in --cycle order).
+"""
+
+import argparse
+import os
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+FIXTURE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures")
+
+
+class FixtureHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def pick_fixture(self):
+        name = os.path.basename(self.path.split("?", 1)[0])
+        if name.endswith(".json") and os.path.exists(os.path.join(FIXTURE_DIR, name)):
+            return name
+        opts = self.server.opts
+        if opts.cycle:
+            name = opts.cycle[self.server.served % len(opts.cycle)]
+            self.server.served += 1
+            return name
+        return opts.fixture
+
+    def do_GET(self):
+        opts = self.server.opts
+        name = self.pick_fixture()
+        try:
+            with open(os.path.join(FIXTURE_DIR, name), "rb") as f:
+                body = f.read()
+        except OSError:
+            self.send_error(404, f"no fixture {name}")
+            return
+
+        time.sleep(opts.latency / 1000.0)
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        if opts.chunk > 0:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+
+        if opts.chunk > 0:
+            for i in range(0, len(body), opts.chunk):
+                part = body[i:i + opts.chunk]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(part), part))
+                self.wfile.flush()
+                time.sleep(opts.chunk_delay / 1000.0)
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.wfile.write(body)
+        self.log_message("served %s (%d bytes)", name, len(body))
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    p.add_argument("--port", type=int, default=8080)
+    p.add_argument("--fixture", default="live.json",
+                   help="fixture served for the scoreboard path")
+    p.add_argument("--cycle", nargs="+", metavar="NAME",
+                   help="serve these fixtures in turn, one per request")
+    p.add_argument("--chunk", type=int, default=0,
+                   help="chunked transfer with this many bytes per chunk")
+    p.add_argument("--chunk-delay", type=int, default=0,
+                   help="milliseconds between chunks")
+    p.add_argument("--latency", type=int, default=0,
+                   help="milliseconds before the response headers")
+    opts = p.parse_args()
+
+    server = ThreadingHTTPServer(("", opts.port), FixtureHandler)
+    server.opts = opts
+    server.served = 0
+    print(f"Serving {FIXTURE_DIR} on port {opts.port}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
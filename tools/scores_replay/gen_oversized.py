@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Expand a recorded scoreboard into an oversized payload.
+
+Repeats the events of a fixture (with fresh event IDs) until the body is
+larger than the device's 192 KB response buffer, so both the host parser and
+the on-device truncation path can be exercised.
+
+    python3 gen_oversized.py fixtures/live.json fixtures/oversized.json
+"""
+
+import copy
+import json
+import sys
+
+TARGET_BYTES = 256 * 1024
+
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else "fixtures/live.json"
+    dst = sys.argv[2] if len(sys.argv) > 2 else "fixtures/oversized.json"
+
+    with open(src) as f:
+        doc = json.load(f)
+    base = doc["events"]
+    events = []
+    next_id = 402000000
+    while len(json.dumps(doc | {"events": events}, indent=1)) < TARGET_BYTES:
+        ev = copy.deepcopy(base[len(events) % len(base)])
+        ev["id"] = str(next_id)
+        next_id += 1
+        events.append(ev)
+    doc["events"] = events
+
+    with open(dst, "w") as f:
+        json.dump(doc, f, indent=1)
+    print(f"{dst}: {len(events)} events")
+
+
+if __name__ == "__main__":
+    main()
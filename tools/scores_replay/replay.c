@@ -0,0 +1,185 @@
+// Replays recorded ESPN scoreboard responses through scores_parser on the
+// host and reports parse time, peak heap and the resulting game list.
+//
+//   scores_replay [-n iterations] [-q] fixture.json...
+
+#include "cJSON.h"
+#include "esp_heap_caps.h"
+#include "scores_parser.h"
+#include "team_registry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_GAMES 20 // Same capacity as sports_scores.c
+
+// Every allocation carries its size so frees can be accounted for
+typedef struct {
+  size_t size;
+  size_t pad; // Keep the payload 16-byte aligned
+} alloc_hdr_t;
+
+static size_t heap_live = 0;
+static size_t heap_peak = 0;
+
+static void *counted_malloc(size_t size) {
+  alloc_hdr_t *hdr = malloc(sizeof(alloc_hdr_t) + size);
+  if (!hdr)
+    return NULL;
+  hdr->size = size;
+  heap_live += size;
+  if (heap_live > heap_peak)
+    heap_peak = heap_live;
+  return hdr + 1;
+}
+
+static void counted_free(void *ptr) {
+  if (!ptr)
+    return;
+  alloc_hdr_t *hdr = (alloc_hdr_t *)ptr - 1;
+  heap_live -= hdr->size;
+  free(hdr);
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  (void)caps;
+  return counted_malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+  (void)caps;
+  void *ptr = counted_malloc(n * size);
+  if (ptr)
+    memset(ptr, 0, n * size);
+  return ptr;
+}
+
+void heap_caps_free(void *ptr) { counted_free(ptr); }
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static char *read_file(const char *path, long *len_out) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return NULL;
+  fseek(f, 0, SEEK_END);
+  long len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char *buf = malloc(len + 1);
+  if (buf && fread(buf, 1, len, f) != (size_t)len) {
+    free(buf);
+    buf = NULL;
+  }
+  fclose(f);
+  if (buf) {
+    buf[len] = '\0';
+    *len_out = len;
+  }
+  return buf;
+}
+
+static void print_games(const game_info_t *games, int count) {
+  printf("  %-10s %-4s %4s   %-4s %4s  %s\n", "id", "away", "", "home", "",
+         "status");
+  for (int i = 0; i < count; i++) {
+    const game_info_t *g = &games[i];
+    printf("  %-10lu %-4s %4d @ %-4s %4d  %s%s\n", (unsigned long)g->id,
+           team_registry_abbrev(g->away_team), g->away_score,
+           team_registry_abbrev(g->home_team), g->home_score, g->status,
+           g->is_live ? " [live]" : "");
+  }
+}
+
+static int replay_fixture(const char *path, int iterations, bool quiet) {
+  long len = 0;
+  char *json = read_file(path, &len);
+  if (!json) {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return 1;
+  }
+
+  printf("== %s (%ld bytes)\n", path, len);
+
+  // First pass interns the teams so the timed runs measure steady state
+  game_info_t games[MAX_GAMES];
+  int parsed = scores_parser_parse(json, games, MAX_GAMES);
+  if (parsed < 0) {
+    // Rejected payloads (e.g. truncated) are a result, not a harness error
+    printf("  parse failed, cache would be kept\n");
+    free(json);
+    return 0;
+  }
+  int kept = scores_parser_filter(games, parsed);
+  printf("  parsed %d games, kept %d\n", parsed, kept);
+  if (!quiet)
+    print_games(games, kept);
+
+  double t_min = 1e12, t_max = 0, t_sum = 0;
+  size_t baseline = heap_live;
+  heap_peak = heap_live;
+  for (int i = 0; i < iterations; i++) {
+    game_info_t scratch[MAX_GAMES];
+    double t0 = now_us();
+    int n = scores_parser_parse(json, scratch, MAX_GAMES);
+    if (n > 0)
+      scores_parser_filter(scratch, n);
+    double dt = now_us() - t0;
+    t_sum += dt;
+    if (dt < t_min)
+      t_min = dt;
+    if (dt > t_max)
+      t_max = dt;
+  }
+
+  if (iterations > 0) {
+    printf("  parse+filter: min %.1f us, avg %.1f us, max %.1f us (%d runs)\n",
+           t_min, t_sum / iterations, t_max, iterations);
+    printf("  peak heap: %zu bytes above %zu resident\n", heap_peak - baseline,
+           baseline);
+  }
+
+  free(json);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int iterations = 100;
+  bool quiet = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:q")) != -1) {
+    switch (opt) {
+    case 'n':
+      iterations = atoi(optarg);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-n iterations] [-q] fixture.json...\n",
+              argv[0]);
+      return 2;
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "usage: %s [-n iterations] [-q] fixture.json...\n",
+            argv[0]);
+    return 2;
+  }
+
+  // Route cJSON through the same counters as the team registry
+  cJSON_Hooks hooks = {.malloc_fn = counted_malloc, .free_fn = counted_free};
+  cJSON_InitHooks(&hooks);
+
+  int failures = 0;
+  for (int i = optind; i < argc; i++) {
+    failures += replay_fixture(argv[i], iterations, quiet);
+  }
+  return failures ? 1 : 0;
+}
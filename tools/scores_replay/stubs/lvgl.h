@@ -0,0 +1,19 @@
+#ifndef LVGL_H
+#define LVGL_H
+
+// Host stand-in for the types dashboard_screen.h and seven_seg.h use
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef int16_t lv_coord_t;
+
+typedef struct {
+  lv_coord_t x1;
+  lv_coord_t y1;
+  lv_coord_t x2;
+  lv_coord_t y2;
+} lv_area_t;
+
+#endif // LVGL_H
@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""Render the static dashboard chrome into the RLCD's packed framebuffer.
+
+The output is a C file holding a const copy of DisplayPort::DispBuffer
+(400x300 landscape, 1 bit per pixel, 1 = white) that RLCD_Init pushes to
+the panel before LVGL has started. Only the parts of the dashboard that
+never change are drawn: borders, title bar, dividers, the battery outline
+and the TEMP / HUMIDITY captions. LVGL redraws the whole screen on its
+first frame, so anything missing here simply appears a moment later.
+
+Geometry mirrors dashboard_create() in
+components/ui_bsp/custom/dashboard_screen.c; keep the two in sync.
+Captions are rasterized from the same LVGL font source the firmware
+links, with its kerning and LVGL 8's glyph placement, and thresholded the
+way the flush callback does (coverage >= 50% is black).
+
+Run by the port_bsp component build; by hand:
+
+    python3 tools/splash/gen_splash.py \\
+        --font components/ui_bsp/generated/guider_fonts/lv_font_MISANSMEDIUM_18.c \\
+        -o splash_frame.c --png splash.png
+"""
+
+import argparse
+import re
+import struct
+import zlib
+
+SCREEN_W = 400
+SCREEN_H = 300
+
+# dashboard_screen.c
+TITLE_BAR_H = 22
+CONTENT_Y = 4 + TITLE_BAR_H + 4
+# status_icons.c
+BATT_W = 24
+BATT_H = 10
+BATT_TIP_W = 2
+BATT_TIP_H = 4
+RIGHT_X = 212
+
+BLACK = 0
+WHITE = 1
+
+
+class Canvas:
+    def __init__(self, w, h):
+        self.w = w
+        self.h = h
+        self.px = bytearray([WHITE]) * (w * h)
+
+    def set(self, x, y, color):
+        if 0 <= x < self.w and 0 <= y < self.h:
+            self.px[y * self.w + x] = color
+
+    def fill(self, x, y, w, h, color):
+        for yy in range(y, y + h):
+            for xx in range(x, x + w):
+                self.set(xx, yy, color)
+
+    def border(self, x, y, w, h, width, color):
+        self.fill(x, y, w, width, color)
+        self.fill(x, y + h - width, w, width, color)
+        self.fill(x, y, width, h, color)
+        self.fill(x + w - width, y, width, h, color)
+
+
+class Font:
+    """Subset of an lv_font_conv C file: ASCII glyphs, bpp 4, class kerning."""
+
+    def __init__(self, path):
+        src = open(path, encoding="utf-8").read()
+        self.line_height = int(re.search(r"\.line_height\s*=\s*(\d+)", src).group(1))
+        self.base_line = int(re.search(r"\.base_line\s*=\s*(\d+)", src).group(1))
+        self.bpp = int(re.search(r"\.bpp\s*=\s*(\d+)", src).group(1))
+        self.kern_scale = int(re.search(r"\.kern_scale\s*=\s*(\d+)", src).group(1))
+        if self.bpp != 4:
+            raise SystemExit("only 4 bpp fonts are supported")
+
+        self.bitmap = bytes(int(v, 16) for v in re.findall(
+            r"0x([0-9a-fA-F]+)", self._array(src, "glyph_bitmap")))
+
+        self.glyphs = []
+        for m in re.finditer(
+                r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), "
+                r"\.box_h = (\d+), \.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", src):
+            self.glyphs.append(tuple(int(v) for v in m.groups()))
+
+        cmap = re.search(r"\.range_start = (\d+), \.range_length = (\d+), "
+                         r"\.glyph_id_start = (\d+)", src)
+        self.range_start, self.range_length, self.gid_start = (
+            int(v) for v in cmap.groups())
+
+        self.left_map = self._ints(self._array(src, "kern_left_class_mapping"))
+        self.right_map = self._ints(self._array(src, "kern_right_class_mapping"))
+        self.pair_values = self._ints(self._array(src, "kern_class_values"))
+        self.right_cnt = int(re.search(r"\.right_class_cnt\s*=\s*(\d+)", src).group(1))
+
+    @staticmethod
+    def _array(src, name):
+        m = re.search(name + r"\[\]\s*=\s*\{(.*?)\};", src, re.S)
+        if not m:
+            raise SystemExit("array %s not found" % name)
+        # Drop /* U+0041 "A" */ style comments before scanning for numbers
+        return re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+
+    @staticmethod
+    def _ints(body):
+        return [int(v) for v in re.findall(r"-?\d+", body)]
+
+    def gid(self, ch):
+        code = ord(ch)
+        if self.range_start <= code < self.range_start + self.range_length:
+            return self.gid_start + code - self.range_start
+        return 0
+
+    def kern(self, left, right):
+        lc = self.left_map[left]
+        rc = self.right_map[right]
+        if lc == 0 or rc == 0:
+            return 0
+        return self.pair_values[(lc - 1) * self.right_cnt + (rc - 1)]
+
+    def advance(self, ch, next_ch):
+        # lv_font_get_glyph_dsc_fmt_txt(): adv_w is 1/16 px, kerning scaled
+        gid = self.gid(ch)
+        adv = self.glyphs[gid][1]
+        if next_ch:
+            adv += (self.kern(gid, self.gid(next_ch)) * self.kern_scale) >> 4
+        return (adv + 8) >> 4
+
+    def coverage(self, gid, x, y):
+        index, _, box_w, _, _, _ = self.glyphs[gid]
+        nibble = y * box_w + x
+        byte = self.bitmap[index + nibble // 2]
+        return (byte >> 4) if nibble % 2 == 0 else (byte & 0x0F)
+
+    def draw(self, canvas, x, y, text, color):
+        # lv_draw_label() / lv_draw_letter() placement for a one-line label
+        for i, ch in enumerate(text):
+            gid = self.gid(ch)
+            _, _, box_w, box_h, ofs_x, ofs_y = self.glyphs[gid]
+            gx = x + ofs_x
+            gy = y + (self.line_height - self.base_line) - box_h - ofs_y
+            for row in range(box_h):
+                for col in range(box_w):
+                    # 4 bpp coverage v blends at opacity v * 17; the flush
+                    # callback turns anything at least half black to black
+                    if self.coverage(gid, col, row) >= 8:
+                        canvas.set(gx + col, gy + row, color)
+            x += self.advance(ch, text[i + 1] if i + 1 < len(text) else None)
+
+
+def render(font):
+    c = Canvas(SCREEN_W, SCREEN_H)
+
+    # Outer and inner frame borders
+    c.border(0, 0, SCREEN_W, SCREEN_H, 2, BLACK)
+    c.border(3, 3, SCREEN_W - 6, SCREEN_H - 6, 1, BLACK)
+
+    # Title bar, with the battery outline and tip (fill and WiFi bars are
+    # dynamic; the "RLCD" title uses a built-in LVGL font and is left out)
+    c.fill(4, 4, SCREEN_W - 8, TITLE_BAR_H, BLACK)
+    batt_x = 4 + SCREEN_W - 80
+    batt_y = 4 + 4 + 1
+    c.border(batt_x, batt_y, BATT_W, BATT_H, 1, WHITE)
+    for cx, cy in ((batt_x, batt_y), (batt_x + BATT_W - 1, batt_y),
+                   (batt_x, batt_y + BATT_H - 1),
+                   (batt_x + BATT_W - 1, batt_y + BATT_H - 1)):
+        c.set(cx, cy, BLACK)  # radius 1
+    c.fill(batt_x + BATT_W, 4 + 4 + (BATT_H - BATT_TIP_H) // 2 + 1,
+           BATT_TIP_W, BATT_TIP_H, WHITE)
+
+    # Section captions
+    font.draw(c, 15, CONTENT_Y + 125, "TEMP", BLACK)
+    font.draw(c, 15, CONTENT_Y + 185, "HUMIDITY", BLACK)
+
+    # Dividers: below the clock, between columns, between the two games
+    c.fill(10, CONTENT_Y + 118, 190, 2, BLACK)
+    c.fill(205, CONTENT_Y + 5, 2, SCREEN_H - CONTENT_Y - 15, BLACK)
+    c.fill(RIGHT_X, CONTENT_Y + 106, SCREEN_W - RIGHT_X - 10, 1, BLACK)
+    return c
+
+
+def pack(canvas):
+    # DisplayPort::InitLandscapeLUT(): 2x4 pixel cells, columns of cells
+    # bottom-up, bit 7 first
+    h4 = canvas.h // 4
+    out = bytearray((canvas.w * canvas.h) // 8)
+    for y in range(canvas.h):
+        inv_y = canvas.h - 1 - y
+        block_y = inv_y >> 2
+        local_y = inv_y & 3
+        for x in range(canvas.w):
+            if canvas.px[y * canvas.w + x]:
+                index = (x >> 1) * h4 + block_y
+                out[index] |= 1 << (7 - ((local_y << 1) | (x & 1)))
+    return out
+
+
+def write_c(path, data):
+    lines = [
+        "// Generated by tools/splash/gen_splash.py; do not edit.",
+        "#include \"splash_frame.h\"",
+        "",
+        "const uint32_t rlcd_splash_frame_len = %d;" % len(data),
+        "const uint8_t rlcd_splash_frame[%d] = {" % len(data),
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def write_png(path, canvas):
+    raw = b"".join(
+        b"\x00" + bytes(255 if canvas.px[y * canvas.w + x] else 0
+                        for x in range(canvas.w))
+        for y in range(canvas.h))
+
+    def chunk(tag, body):
+        return (struct.pack(">I", len(body)) + tag + body +
+                struct.pack(">I", zlib.crc32(tag + body) & 0xFFFFFFFF))
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", canvas.w, canvas.h,
+                                           8, 0, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--font", required=True, help="lv_font_MISANSMEDIUM_18.c")
+    ap.add_argument("-o", "--output", required=True, help="C file to write")
+    ap.add_argument("--png", help="also write a preview image")
+    args = ap.parse_args()
+
+    canvas = render(Font(args.font))
+    write_c(args.output, pack(canvas))
+    if args.png:
+        write_png(args.png, canvas)
+
+
+if __name__ == "__main__":
+    main()